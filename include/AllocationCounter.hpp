@@ -0,0 +1,23 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstdint>
+
+/**
+ * @class AllocationCounter
+ * @brief 统计本线程调用全局 operator new 的次数
+ * @details 只有定义了 RUBIK_COUNT_ALLOCATIONS（CMake 选项
+ *          -DRUBIK_COUNT_ALLOCATIONS=ON）时，AllocationCounter.cpp 才会链接进
+ *          rubik 并替换全局 operator new/delete；默认构建不替换分配器。
+ *          按线程计数，不把录像、求解等后台线程同时发生的分配算进去
+ */
+class AllocationCounter {
+public:
+  /**
+   * @brief 获取本线程到目前为止的分配次数
+   * @return 次数
+   */
+  static uint64_t count();
+};
+
+#endif
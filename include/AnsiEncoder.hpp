@@ -0,0 +1,48 @@
+#ifndef ANSI_ENCODER_HPP
+#define ANSI_ENCODER_HPP
+
+#include "CellBuffer.hpp"
+#include <string>
+
+/**
+ * @class AnsiEncoder
+ * @brief 把离屏缓冲区编码为相对上一帧的 ANSI 转义序列
+ * @details 与上一帧比较，只输出变化的格子；光标连续时不重复定位，颜色
+ *          属性不变时不重复设置。输出缓冲区和上一帧都重复使用，稳定状态下
+ *          不做堆分配。AnsiRenderer 用它写终端，AsciicastRecorder 用它
+ *          生成录像事件
+ */
+class AnsiEncoder {
+public:
+  static constexpr int MAX_SKIP = 4; ///< 不移动光标、直接重写的最长未变化段
+
+  /**
+   * @brief 构造函数（第一帧完整重绘）
+   */
+  AnsiEncoder();
+
+  /**
+   * @brief 编码一帧，并把它记为下一帧的比较基准
+   * @param buffer 离屏缓冲区
+   * @return 转义序列（下次调用前有效）
+   */
+  const std::string &encode(const CellBuffer &buffer);
+
+  /**
+   * @brief 接收方的屏幕内容未知，下一帧先清屏再完整重绘
+   */
+  void invalidate() { fullRedraw = true; }
+
+private:
+  /**
+   * @brief 追加一个非负整数的十进制表示
+   * @param value 数值
+   */
+  void appendNumber(int value);
+
+  std::string out;     ///< 输出缓冲区
+  CellBuffer previous; ///< 上一帧（接收方屏幕上当前的内容）
+  bool fullRedraw;     ///< 下一帧是否完整重绘
+};
+
+#endif
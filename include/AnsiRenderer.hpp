@@ -0,0 +1,35 @@
+#ifndef ANSI_RENDERER_HPP
+#define ANSI_RENDERER_HPP
+
+#include "AnsiEncoder.hpp"
+#include "Renderer.hpp"
+
+/**
+ * @class AnsiRenderer
+ * @brief 直接向文件描述符写 ANSI 转义序列的后端
+ * @details 由 AnsiEncoder 生成只含变化格子的转义序列，整帧用尽量少的
+ *          write() 一次写出
+ */
+class AnsiRenderer : public Renderer {
+public:
+  /**
+   * @brief 构造函数
+   * @param fd 输出的文件描述符（不会被关闭）
+   */
+  explicit AnsiRenderer(int fd);
+
+  const char *name() const override { return "ansi"; }
+
+  void present(const CellBuffer &buffer) override;
+
+  void invalidate() override { encoder.invalidate(); }
+
+  uint64_t bytesWritten() const override { return totalBytes; }
+
+private:
+  int fd;              ///< 输出的文件描述符
+  AnsiEncoder encoder; ///< 帧差编码器
+  uint64_t totalBytes; ///< 累计输出的字节数
+};
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef ASCIICAST_RECORDER_HPP
+#define ASCIICAST_RECORDER_HPP
+
+#include "AnsiEncoder.hpp"
+#include "CellBuffer.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class AsciicastRecorder
+ * @brief 把每帧画面录制为 asciicast v2 文件，可用 asciinema play 等播放
+ * @details record() 把画面与一个可复用槽里的缓冲区交换后交给写入线程，
+ *          不复制格子；帧差编码（AnsiEncoder，每个事件只含变化的格子）、
+ *          JSON 转义和写文件都在写入线程上进行。写入线程落后超过
+ *          QUEUE_FRAMES 帧时跳过新帧，下一帧仍与最后写出的一帧比较，回放
+ *          画面保持正确
+ */
+class AsciicastRecorder {
+public:
+  static constexpr size_t QUEUE_FRAMES = 8; ///< 最多排队的帧数
+
+  /**
+   * @brief 构造函数（未打开文件时 record() 不做任何事）
+   */
+  AsciicastRecorder();
+
+  /**
+   * @brief 析构函数，写完排队的帧并关闭文件
+   */
+  ~AsciicastRecorder();
+
+  AsciicastRecorder(const AsciicastRecorder &) = delete;
+  AsciicastRecorder &operator=(const AsciicastRecorder &) = delete;
+
+  /**
+   * @brief 创建录像文件并启动写入线程
+   * @param path 文件路径
+   * @return 成功返回true
+   */
+  bool open(const std::string &path);
+
+  /**
+   * @brief 录制一帧
+   * @param frame 画面；录制后换成尺寸相同、内容不确定的缓冲区（跳过该帧
+   *              时不变），调用方须已用完其内容
+   * @param seconds 距离录制开始的时间（秒）
+   */
+  void record(CellBuffer &frame, double seconds);
+
+  /**
+   * @brief 等到队列有空位（无终端回放在每帧开始前调用，之后的 record()
+   *        不会跳帧，录像与回放一样确定；等待不计入帧耗时）
+   */
+  void waitForSpace();
+
+  /**
+   * @brief 写完排队的帧并关闭文件
+   * @return 文件完整写出返回true
+   */
+  bool close();
+
+  /**
+   * @brief 是否正在录制
+   * @return 已打开返回true
+   */
+  bool isOpen() const { return file != nullptr; }
+
+  /**
+   * @brief 写出的帧数
+   * @return 帧数（写入线程结束后准确）
+   */
+  uint64_t framesWritten() const { return writtenFrames; }
+
+  /**
+   * @brief 因写入线程落后而跳过的帧数
+   * @return 帧数
+   */
+  uint64_t framesDropped() const { return droppedFrames; }
+
+  /**
+   * @brief 写出的字节数
+   * @return 字节数（写入线程结束后准确）
+   */
+  uint64_t bytesWritten() const { return writtenBytes; }
+
+private:
+  /**
+   * @struct Slot
+   * @brief 排队中的一帧
+   */
+  struct Slot {
+    CellBuffer frame; ///< 画面（与调用方交换得到）
+    double seconds;   ///< 时间戳（秒）
+  };
+
+  /**
+   * @brief 写入线程主循环
+   */
+  void run();
+
+  /**
+   * @brief 编码一帧并写入文件（写入线程）
+   * @param slot 排队的帧
+   */
+  void writeFrame(const Slot &slot);
+
+  /**
+   * @brief 写一个事件行（JSON 转义数据）
+   * @param seconds 时间戳
+   * @param type 事件类型（"o" 输出，"r" 改变尺寸）
+   * @param data 数据
+   */
+  void writeEvent(double seconds, const char *type, const std::string &data);
+
+  FILE *file;                    ///< 录像文件
+  std::mutex mutex;              ///< 保护以下队列和状态
+  std::condition_variable wake;  ///< 有新帧或需要结束
+  std::condition_variable space; ///< 写入线程取走了一帧
+  std::deque<Slot> queue;        ///< 等待写入的帧
+  std::vector<Slot> spare;       ///< 可复用的槽
+  bool stopping;                 ///< 正在关闭
+  uint64_t droppedFrames;        ///< 跳过的帧数
+  std::thread thread;            ///< 写入线程
+
+  // 以下只由写入线程访问
+  AnsiEncoder encoder;    ///< 帧差编码器
+  std::string line;       ///< 事件行缓冲区
+  std::time_t startTime;  ///< 开始录制的时刻（写入文件头）
+  int width;              ///< 最近一帧的宽度（0：尚未写文件头）
+  int height;             ///< 最近一帧的高度
+  uint64_t writtenFrames; ///< 写出的帧数
+  uint64_t writtenBytes;  ///< 写出的字节数
+  bool failed;            ///< 写文件出错
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef BIDIRECTIONAL_SOLVER_HPP
+#define BIDIRECTIONAL_SOLVER_HPP
+
+#include "CubeState.hpp"
+#include "Move.hpp"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct FrontierLevel
+ * @brief 双向搜索展开一层的记录
+ */
+struct FrontierLevel {
+  bool backward;       ///< 展开的是还原状态一侧
+  int depth;           ///< 展开后该侧的深度
+  size_t generated;    ///< 生成的子状态数（去重前）
+  size_t states;       ///< 新一层的状态数
+  double milliseconds; ///< 耗时（毫秒）
+};
+
+/**
+ * @struct BidirectionalStats
+ * @brief 一次求解的统计
+ */
+struct BidirectionalStats {
+  std::vector<FrontierLevel> levels; ///< 本次展开的各层（按展开顺序）
+  int cachedDepth = 0;               ///< 开始时已缓存的还原一侧深度
+  size_t peakBytes = 0;              ///< 各层数组占用内存的峰值
+  bool limitReached = false;         ///< 再展开一层会超过内存上限而放弃
+  bool depthReached = false;         ///< 两侧深度之和已达步数上限而放弃
+};
+
+/**
+ * @class BidirectionalSolver
+ * @brief 距还原状态不远（十几步以内）的状态的最优求解器
+ * @details 从给定状态和还原状态同时做广度优先搜索，每次展开较小的一侧。
+ *          每层是按规范编码（StateCode）排序、去重的数组：新一层的子状态
+ *          排序后去掉已在本侧上两层出现的状态，再与另一侧最深的一层求交；
+ *          第一次相交时两侧深度之和即最优步数（半圈计一步），然后沿各层
+ *          逐层找回路径。还原一侧与所求状态无关，在求解之间缓存复用。
+ *          所有层（含缓存）占用的内存不超过构造时给定的上限，
+ *          再展开一层会超过上限时放弃；两侧深度之和达到步数上限时也放弃，
+ *          用来限制无解时所花的时间
+ */
+class BidirectionalSolver {
+public:
+  static constexpr size_t DEFAULT_MEMORY_MB = 1024; ///< 默认内存上限（MB）
+  static constexpr int DEFAULT_MAX_DEPTH = 20;      ///< 默认步数上限（不限制）
+
+  /**
+   * @brief 构造函数
+   * @param memoryLimit 各层数组的内存上限（字节）
+   * @param maxDepth 只求不超过这么多步的解
+   */
+  explicit BidirectionalSolver(size_t memoryLimit = DEFAULT_MEMORY_MB << 20,
+                               int maxDepth = DEFAULT_MAX_DEPTH);
+
+  /**
+   * @brief 求最优解
+   * @param state 魔方状态（须合法）
+   * @param solution 输出的转动序列
+   * @param cancel 取消标志，置为true后尽快返回；为空时不检查
+   * @return 找到解返回true；被取消或达到内存、步数上限返回false
+   */
+  bool solve(const CubeState &state, std::vector<Move> &solution,
+             const std::atomic<bool> *cancel = nullptr);
+
+  /**
+   * @brief 获取最近一次求解的统计
+   * @return 统计
+   */
+  const BidirectionalStats &lastStats() const { return stats; }
+
+  /**
+   * @brief 获取内存上限
+   * @return 字节数
+   */
+  size_t memoryLimit() const { return limit; }
+
+  /**
+   * @brief 获取步数上限
+   * @return 步数
+   */
+  int maxDepth() const { return depthLimit; }
+
+  /**
+   * @brief 释放缓存的还原一侧各层
+   */
+  void clearCache();
+
+private:
+  using Level = std::vector<StateCode>; ///< 一层（按编码排序）
+
+  /**
+   * @brief 展开一侧的最深一层
+   * @param levels 该侧各层
+   * @param backward 是否为还原一侧（只用于统计）
+   * @param cancel 取消标志
+   * @return 展开完成返回true
+   */
+  bool expand(std::vector<Level> &levels, bool backward,
+              const std::atomic<bool> *cancel);
+
+  /**
+   * @brief 从某层的状态沿各层走回第0层
+   * @param levels 该侧各层
+   * @param state 位于第 depth 层的状态
+   * @param depth 层号
+   * @param path 输出每步所走的转动（state · path[0] 位于上一层，依此类推）
+   */
+  static void walkBack(const std::vector<Level> &levels, CubeState state,
+                       int depth, std::vector<Move> &path);
+
+  /**
+   * @brief 统计各层占用的内存
+   * @return 字节数
+   */
+  size_t usedBytes() const;
+
+  size_t limit;                   ///< 内存上限（字节）
+  int depthLimit;                 ///< 步数上限
+  std::vector<Level> goalLevels;  ///< 还原一侧的各层（跨求解缓存）
+  std::vector<Level> startLevels; ///< 所求状态一侧的各层
+  BidirectionalStats stats;       ///< 最近一次求解的统计
+};
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef CELL_BUFFER_HPP
+#define CELL_BUFFER_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct Cell
+ * @brief 终端上的一个字符格
+ */
+struct Cell {
+  char ch;       ///< 字符
+  int16_t color; ///< 前景色（终端256色索引，-1 为默认色）
+  uint8_t attr;  ///< 属性位（见 CellBuffer::ATTR_*）
+
+  bool operator==(const Cell &other) const {
+    return ch == other.ch && color == other.color && attr == other.attr;
+  }
+  bool operator!=(const Cell &other) const { return !(*this == other); }
+};
+
+/**
+ * @class CellBuffer
+ * @brief 离屏字符缓冲区
+ * @details 渲染代码只写入缓冲区，不直接调用终端库；输出到 ncurses、
+ *          计算帧哈希等都从缓冲区读取。越界写入会被忽略
+ */
+class CellBuffer {
+public:
+  static constexpr uint8_t ATTR_NONE = 0;    ///< 无属性
+  static constexpr uint8_t ATTR_REVERSE = 1; ///< 反色
+
+  /**
+   * @brief 构造函数
+   * @param width 宽度（列数）
+   * @param height 高度（行数）
+   */
+  CellBuffer(int width = 0, int height = 0);
+
+  /**
+   * @brief 改变尺寸并清空
+   * @param width 宽度
+   * @param height 高度
+   */
+  void resize(int width, int height);
+
+  /**
+   * @brief 把所有格子置为空格
+   */
+  void clear();
+
+  /**
+   * @brief 写入一个格子
+   * @param x 列
+   * @param y 行
+   * @param ch 字符
+   * @param color 前景色（-1 为默认色）
+   * @param attr 属性
+   */
+  void set(int x, int y, char ch, int color = -1, uint8_t attr = ATTR_NONE) {
+    if (x >= 0 && y >= 0 && x < bufferWidth && y < bufferHeight) {
+      cells[y * bufferWidth + x] = {ch, static_cast<int16_t>(color), attr};
+    }
+  }
+
+  /**
+   * @brief 从指定位置开始写入一行文本
+   * @param x 起始列
+   * @param y 行
+   * @param text 文本
+   * @param attr 属性
+   */
+  void text(int x, int y, const char *text, uint8_t attr = ATTR_NONE);
+
+  /**
+   * @brief 从指定位置开始写入一行文本
+   * @param x 起始列
+   * @param y 行
+   * @param text 文本
+   * @param attr 属性
+   */
+  void text(int x, int y, const std::string &text,
+            uint8_t attr = ATTR_NONE) {
+    this->text(x, y, text.c_str(), attr);
+  }
+
+  /**
+   * @brief 用同一个格子填充一行中的一段（超出部分被裁剪）
+   * @param y 行
+   * @param x0 起始列（含）
+   * @param x1 结束列（含）
+   * @param ch 字符
+   * @param color 前景色（-1 为默认色）
+   * @param attr 属性
+   */
+  void fill(int y, int x0, int x1, char ch, int color = -1,
+            uint8_t attr = ATTR_NONE);
+
+  /**
+   * @brief 把另一个缓冲区整体复制到指定位置（超出部分被裁剪）
+   * @param source 源缓冲区
+   * @param x 目标左上角列
+   * @param y 目标左上角行
+   */
+  void blit(const CellBuffer &source, int x, int y);
+
+  /**
+   * @brief 读取一个格子（不检查越界）
+   * @param x 列
+   * @param y 行
+   * @return 格子
+   */
+  const Cell &at(int x, int y) const { return cells[y * bufferWidth + x]; }
+
+  /**
+   * @brief 获取宽度
+   * @return 列数
+   */
+  int width() const { return bufferWidth; }
+
+  /**
+   * @brief 获取高度
+   * @return 行数
+   */
+  int height() const { return bufferHeight; }
+
+  /**
+   * @brief 计算内容的哈希（FNV-1a，用于比较帧是否一致）
+   * @return 64位哈希
+   */
+  uint64_t hash() const;
+
+  /**
+   * @brief 与另一个缓冲区交换内容和尺寸（不复制格子）
+   * @param other 另一个缓冲区
+   */
+  void swap(CellBuffer &other) {
+    cells.swap(other.cells);
+    std::swap(bufferWidth, other.bufferWidth);
+    std::swap(bufferHeight, other.bufferHeight);
+  }
+
+private:
+  std::vector<Cell> cells; ///< 按行存储的格子
+  int bufferWidth;         ///< 宽度
+  int bufferHeight;        ///< 高度
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef CUBE_FORMAT_HPP
+#define CUBE_FORMAT_HPP
+
+#include "CubeState.hpp"
+#include "Enums.hpp"
+#include "FaceletCube.hpp"
+#include <cstddef>
+#include <string>
+
+/**
+ * @class CubeFormat
+ * @brief 魔方状态的文本格式与合法性校验
+ * @details 面块字符串：54 个字母，按 URFDLB 顺序每面 9 个（与 FaceletCube
+ *          的贴纸顺序相同），每个字母是该贴纸颜色所属的面，还原状态为
+ *          "UUUUUUUUURRRRRRRRRFFFFFFFFFDDDDDDDDDLLLLLLLLLBBBBBBBBB"。
+ *          块记号：按 "UF UR UB UL DF DR DB DL FR FL BR BL UFR URB UBL ULF
+ *          DRF DFL DLB DBR" 的位置顺序，写出每个位置上的块按位置名称中
+ *          各面顺序读到的颜色，以空白分隔（还原状态即上面这串）。
+ *          单个状态的转换只查表、不分配内存
+ */
+class CubeFormat {
+public:
+  static constexpr size_t FACELET_LENGTH = 54; ///< 面块字符串长度
+  static constexpr size_t CUBIE_LENGTH = 67;   ///< 块记号长度（单个空格分隔）
+  static constexpr size_t LINE_LENGTH = 55;    ///< 批量格式每行长度（含换行）
+
+  /**
+   * @brief 校验块级状态是否可由面转动得到
+   * @param state 块级状态
+   * @return 校验结果（按缺块/重复、朝向、翻转、奇偶性的顺序报告第一个错误）
+   */
+  static StateError validate(const CubeState &state);
+
+  /**
+   * @brief 由贴纸识别块级状态并校验
+   * @param cube 贴纸表示（颜色须为 0-5）
+   * @param state 输出的状态（仅在返回 STATE_OK 时完整）
+   * @return 校验结果
+   */
+  static StateError fromFacelets(const FaceletCube &cube, CubeState &state);
+
+  /**
+   * @brief 解析面块字符串
+   * @param text 文本（不要求以0结尾）
+   * @param length 文本长度（须为 FACELET_LENGTH）
+   * @param state 输出的状态
+   * @return 校验结果
+   */
+  static StateError parseFacelets(const char *text, size_t length,
+                                  CubeState &state);
+
+  /**
+   * @brief 写出面块字符串
+   * @param state 块级状态
+   * @param text 输出缓冲区，写入 FACELET_LENGTH 个字符（不写结尾的0）
+   */
+  static void formatFacelets(const CubeState &state, char *text);
+
+  /**
+   * @brief 写出面块字符串
+   * @param state 块级状态
+   * @return 面块字符串
+   */
+  static std::string toFacelets(const CubeState &state);
+
+  /**
+   * @brief 解析块记号（任意空白分隔，首尾可有空白）
+   * @param text 文本（不要求以0结尾）
+   * @param length 文本长度
+   * @param state 输出的状态
+   * @return 校验结果
+   */
+  static StateError parseCubies(const char *text, size_t length,
+                                CubeState &state);
+
+  /**
+   * @brief 写出块记号
+   * @param state 块级状态
+   * @param text 输出缓冲区，写入 CUBIE_LENGTH 个字符（不写结尾的0）
+   */
+  static void formatCubies(const CubeState &state, char *text);
+
+  /**
+   * @brief 写出块记号
+   * @param state 块级状态
+   * @return 块记号
+   */
+  static std::string toCubies(const CubeState &state);
+
+  /**
+   * @brief 解析面块字符串或块记号（含空白的按块记号解析）
+   * @param text 文本
+   * @param state 输出的状态
+   * @return 校验结果
+   */
+  static StateError parse(const std::string &text, CubeState &state);
+
+  /**
+   * @brief 批量解析面块字符串，每行 FACELET_LENGTH 个字母加换行
+   * @param text 文本，共 count × LINE_LENGTH 个字符
+   * @param count 行数
+   * @param states 输出的状态数组
+   * @param errors 可选，输出每行的校验结果
+   * @return 合法的行数
+   */
+  static size_t parseFaceletLines(const char *text, size_t count,
+                                  CubeState *states, StateError *errors);
+
+  /**
+   * @brief 批量写出面块字符串，每行加换行
+   * @param states 状态数组
+   * @param count 状态个数
+   * @param text 输出缓冲区，写入 count × LINE_LENGTH 个字符
+   */
+  static void formatFaceletLines(const CubeState *states, size_t count,
+                                 char *text);
+
+  /**
+   * @brief 获取校验结果的名称
+   * @param error 校验结果
+   * @return 名称（如 "ok", "parity"）
+   */
+  static const char *errorName(StateError error);
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef CUBE_GRID_HPP
+#define CUBE_GRID_HPP
+
+#include "CellBuffer.hpp"
+#include "RubiksCube.hpp"
+#include "ThreadPool.hpp"
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @class CubeGrid
+ * @brief 多魔方视图：画面分成网格，每格一个独立播放打乱和还原的魔方
+ * @details 每个魔方渲染到自己的格子缓冲区，再复制到共享缓冲区中互不重叠的
+ *          区域，因此各格可以在线程池上并行渲染，最后整帧只输出一次。
+ *          所有随机数都来自构造时的种子，结果与线程数无关
+ */
+class CubeGrid {
+public:
+  static constexpr int SCRAMBLE_MOVES = 12; ///< 每轮打乱的步数
+
+  /**
+   * @brief 构造函数
+   * @param columns 列数
+   * @param rows 行数
+   * @param seed 随机种子
+   * @param threads 渲染线程数（不大于0时使用硬件并发数）
+   */
+  CubeGrid(int columns, int rows, uint32_t seed, int threads = 0);
+
+  /**
+   * @brief 推进所有魔方；空闲的魔方开始新一轮打乱和还原
+   * @param elapsed 距上次调用经过的时间
+   */
+  void update(std::chrono::nanoseconds elapsed);
+
+  /**
+   * @brief 并行渲染所有格子到缓冲区
+   * @param buffer 目标缓冲区（尺寸即画面尺寸）
+   */
+  void draw(CellBuffer &buffer);
+
+  /**
+   * @brief 渲染线程数
+   * @return 线程数
+   */
+  int threads() const { return pool.size(); }
+
+  /**
+   * @brief 魔方个数
+   * @return 个数
+   */
+  size_t size() const { return tiles.size(); }
+
+private:
+  /**
+   * @struct Tile
+   * @brief 网格中的一格
+   */
+  struct Tile {
+    std::unique_ptr<RubiksCube> cube; ///< 魔方
+    CellBuffer buffer;                ///< 格子自己的缓冲区
+    std::mt19937 random;              ///< 生成打乱序列的随机数发生器
+  };
+
+  /**
+   * @brief 为一格生成新一轮的打乱和还原序列
+   * @param tile 格子
+   */
+  void queueRound(Tile &tile);
+
+  int columns;             ///< 列数
+  int rows;                ///< 行数
+  std::vector<Tile> tiles; ///< 所有格子（按行排列）
+  ThreadPool pool;         ///< 渲染用的线程池
+};
+
+#endif
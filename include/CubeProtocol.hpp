@@ -0,0 +1,52 @@
+#ifndef CUBE_PROTOCOL_HPP
+#define CUBE_PROTOCOL_HPP
+
+#include "Enums.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct CubeProtocol
+ * @brief 控制服务器（CubeServer）与客户端之间的二进制协议
+ * @details 请求和响应都以3字节的头开始，后跟负载，多字节整数均为小端序：
+ *          请求为 [操作码 u8][负载长度 u16][负载]，
+ *          响应为 [状态码 u8][负载长度 u16][负载]。
+ *          转动用一个字节的 Move::index()（0-17）表示。客户端可以连续发送
+ *          多个请求而不等待响应（流水线），服务器按顺序逐一响应。
+ *          各操作的负载：
+ *          - OP_APPLY：请求为转动序列，响应为空
+ *          - OP_STATE：请求为空，响应为 cp[8] co[8] ep[12] eo[12]
+ *          - OP_RESET：请求、响应均为空
+ *          - OP_SCRAMBLE：请求为空或步数（u8），响应为空
+ *          - OP_SOLVE：请求为空，响应为解的转动序列
+ */
+struct CubeProtocol {
+  static constexpr size_t HEADER_SIZE = 3;    ///< 消息头字节数
+  static constexpr size_t MAX_PAYLOAD = 4096; ///< 请求负载上限，超过则断开
+  static constexpr size_t STATE_SIZE = 40;    ///< OP_STATE 响应负载字节数
+  static constexpr int DEFAULT_SCRAMBLE = 20; ///< OP_SCRAMBLE 的默认步数
+
+  /**
+   * @brief 写入消息头
+   * @param out 输出位置（至少 HEADER_SIZE 字节）
+   * @param code 操作码或状态码
+   * @param length 负载长度
+   */
+  static void writeHeader(uint8_t *out, int code, size_t length) {
+    out[0] = static_cast<uint8_t>(code);
+    out[1] = static_cast<uint8_t>(length & 0xFF);
+    out[2] = static_cast<uint8_t>((length >> 8) & 0xFF);
+  }
+
+  /**
+   * @brief 读取消息头中的负载长度
+   * @param header 消息头
+   * @return 负载长度
+   */
+  static size_t payloadLength(const uint8_t *header) {
+    return static_cast<size_t>(header[1]) |
+           (static_cast<size_t>(header[2]) << 8);
+  }
+};
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef CUBE_SERVER_HPP
+#define CUBE_SERVER_HPP
+
+#include "RubiksCube.hpp"
+#include "ThistlethwaiteSolver.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class CubeServer
+ * @brief 监听 Unix 域套接字、供其他进程驱动魔方的控制服务器
+ * @details 单线程 epoll 循环，所有连接都是非阻塞的。每个连接是一个会话，
+ *          拥有自己的 RubiksCube；一次读取中收到的所有完整请求依次处理，
+ *          响应攒在一起写出。响应写不完时暂停读取该连接，直到缓冲区写空，
+ *          慢客户端不会让服务器无限缓存响应。求解耗时几十毫秒，交给后台
+ *          求解线程，完成后通过 eventfd 唤醒事件循环；等待求解的连接暂停
+ *          处理后续请求以保证响应顺序，其他连接不受影响。
+ *          协议见 CubeProtocol.hpp
+ * @note 仅在 Linux 上构建
+ */
+class CubeServer {
+public:
+  /**
+   * @brief 构造函数
+   * @param seed 随机种子，第 n 个会话的魔方使用 seed + n 打乱
+   * @param solverThreads 求解线程数，不大于0时使用硬件线程数减一（至少1）
+   */
+  explicit CubeServer(uint32_t seed, int solverThreads = 0);
+
+  /**
+   * @brief 析构函数，结束求解线程，关闭所有连接并删除套接字文件
+   */
+  ~CubeServer();
+
+  CubeServer(const CubeServer &) = delete;
+  CubeServer &operator=(const CubeServer &) = delete;
+
+  /**
+   * @brief 创建并监听套接字（已存在的同名文件会被删除）
+   * @param path 套接字路径
+   * @return 成功返回true
+   */
+  bool listen(const std::string &path);
+
+  /**
+   * @brief 运行事件循环
+   * @param stop 置为true后在100毫秒内返回
+   */
+  void run(const std::atomic<bool> &stop);
+
+  /**
+   * @brief 累计接受的连接数
+   * @return 连接数
+   */
+  uint64_t sessionsAccepted() const { return sessionCount; }
+
+  /**
+   * @brief 累计处理的请求数
+   * @return 请求数
+   */
+  uint64_t requestsHandled() const { return requestCount; }
+
+  /**
+   * @brief 累计处理的转动数（OP_APPLY）
+   * @return 转动数
+   */
+  uint64_t movesApplied() const { return moveCount; }
+
+private:
+  /**
+   * @struct Session
+   * @brief 一个客户端连接
+   */
+  struct Session {
+    int fd;                           ///< 连接的文件描述符
+    uint64_t id;                      ///< 会话编号（文件描述符会被复用）
+    std::unique_ptr<RubiksCube> cube; ///< 会话自己的魔方
+    std::vector<uint8_t> input;       ///< 尚未处理的请求字节
+    std::vector<uint8_t> output;      ///< 尚未写出的响应
+    size_t written;                   ///< output 中已写出的字节数
+    bool writing;                     ///< 正在等待可写（暂停读取）
+    bool solving;                     ///< 正在等待求解结果（暂停处理）
+    uint32_t events;                  ///< 当前向 epoll 注册的事件
+  };
+
+  /**
+   * @struct SolveJob
+   * @brief 交给求解线程的请求，完成后原样带回结果
+   */
+  struct SolveJob {
+    int fd;                  ///< 连接的文件描述符
+    uint64_t sessionId;      ///< 会话编号，用于丢弃已关闭会话的结果
+    CubeState state;         ///< 待求解的状态
+    std::vector<Move> moves; ///< 求解结果
+  };
+
+  void acceptClients();
+
+  bool readRequests(Session &session);
+
+  bool processInput(Session &session);
+
+  void handleRequest(Session &session, int opcode, const uint8_t *payload,
+                     size_t length);
+
+  void finishSolves();
+
+  bool flushOutput(Session &session);
+
+  void updateEvents(Session &session);
+
+  void closeSession(int fd);
+
+  void solveLoop();
+
+  int listenFd;           ///< 监听套接字
+  int epollFd;            ///< epoll 实例
+  std::string socketPath; ///< 套接字文件路径
+  uint32_t seed;          ///< 会话魔方的随机种子基数
+  std::unordered_map<int, std::unique_ptr<Session>> sessions; ///< 活动连接
+  std::vector<Move> moves;  ///< 解码转动用的临时缓冲区
+  uint64_t sessionCount;    ///< 累计连接数
+  uint64_t requestCount;    ///< 累计请求数
+  uint64_t moveCount;       ///< 累计转动数
+
+  // Solver threads
+  ThistlethwaiteSolver solver;           ///< 求解器（只读，可多线程共用）
+  int wakeFd;                            ///< 求解完成时写入的 eventfd
+  std::mutex solveMutex;                 ///< 保护以下队列
+  std::condition_variable solveReady;    ///< 有新的求解请求
+  std::deque<SolveJob> solveJobs;        ///< 待求解
+  std::deque<SolveJob> solvedJobs;       ///< 已求解、等待事件循环取走
+  bool solveStopping;                    ///< 析构中
+  std::vector<std::thread> solveThreads; ///< 求解线程
+};
+
+#endif
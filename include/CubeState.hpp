@@ -0,0 +1,171 @@
+#ifndef CUBE_STATE_HPP
+#define CUBE_STATE_HPP
+
+#include "Enums.hpp"
+#include "Move.hpp"
+#include "Vector3.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct StateCode
+ * @brief 魔方状态的规范整数编码
+ * @details 角块坐标 = 角块排列秩 × 3^7 + 角块朝向（< 8!·3^7，27位）；
+ *          棱块坐标 = 棱块排列秩/2 × 2^11 + 棱块翻转（< 12!/2·2^11，39位）。
+ *          棱块排列的奇偶性由角块排列决定，因此只需存一半的秩。
+ *          魔方状态总数约 4.3×10^19，超过 2^64，所以规范编码共66位，
+ *          分两个字段存放；hash() 给出用于散列表的64位摘要
+ */
+struct StateCode {
+  uint32_t corners; ///< 角块坐标
+  uint64_t edges;   ///< 棱块坐标
+
+  static constexpr uint32_t CORNER_COUNT = 88179840;      ///< 8!·3^7
+  static constexpr uint64_t EDGE_COUNT = 490497638400ULL; ///< 12!/2·2^11
+
+  /**
+   * @brief 计算64位散列值（splitmix64 混合）
+   * @return 散列值
+   */
+  uint64_t hash() const {
+    uint64_t x = edges ^ (static_cast<uint64_t>(corners) << 39) ^
+                 (static_cast<uint64_t>(corners) >> 25);
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  bool operator==(const StateCode &other) const {
+    return corners == other.corners && edges == other.edges;
+  }
+  bool operator!=(const StateCode &other) const { return !(*this == other); }
+  bool operator<(const StateCode &other) const {
+    return corners != other.corners ? corners < other.corners
+                                    : edges < other.edges;
+  }
+};
+
+/**
+ * @class CubeState
+ * @brief 魔方的块级（cubie）状态：角块/棱块的排列与朝向
+ * @details cp[i] 表示位于位置 i 的角块编号，co[i] 为其朝向（0-2），
+ *          即该角块参考面贴纸位于位置 i 第几个贴纸上；棱块同理（0-1）。
+ *          中心块在面转动下不动，不计入状态。
+ *          转动表由 RotationGroup 几何推导，与 RubiksCube 的渲染约定一致
+ */
+class CubeState {
+public:
+  uint8_t cp[8];  ///< 角块排列
+  uint8_t co[8];  ///< 角块朝向（0-2）
+  uint8_t ep[12]; ///< 棱块排列
+  uint8_t eo[12]; ///< 棱块翻转（0-1）
+
+  /// 每个角块位置上三个贴纸所在的面（第一个为参考面，按顺时针排列）
+  static const Face CORNER_FACES[8][3];
+  /// 每个棱块位置上两个贴纸所在的面（第一个为参考面）
+  static const Face EDGE_FACES[12][2];
+
+  /**
+   * @brief 构造函数，创建已还原状态
+   */
+  CubeState();
+
+  /**
+   * @brief 获取单次面转动对应的状态（作用于还原状态的结果）
+   * @param move 面转动
+   * @return 转动状态
+   */
+  static const CubeState &moveState(const Move &move);
+
+  /**
+   * @brief 状态乘法：先执行 a 再执行 b
+   * @param a 先执行的状态
+   * @param b 后执行的状态
+   * @return 组合后的状态
+   */
+  static CubeState multiply(const CubeState &a, const CubeState &b);
+
+  /**
+   * @brief 执行一次面转动
+   * @param move 面转动
+   */
+  void apply(const Move &move);
+
+  /**
+   * @brief 执行转动序列
+   * @param moves 转动序列首地址
+   * @param count 转动个数
+   */
+  void applyMoves(const Move *moves, size_t count);
+
+  /**
+   * @brief 计算逆状态
+   * @return 满足 this * inverse = 还原状态 的状态
+   */
+  CubeState inverse() const;
+
+  /**
+   * @brief 判断是否为还原状态
+   * @return 已还原返回true
+   */
+  bool isSolved() const;
+
+  /**
+   * @brief 编码为规范整数
+   * @return 状态编码
+   * @note 要求状态合法（角块、棱块排列奇偶性一致）
+   */
+  StateCode encode() const;
+
+  /**
+   * @brief 从规范整数解码
+   * @param code 状态编码
+   * @return 对应的状态
+   */
+  static CubeState decode(const StateCode &code);
+
+  /**
+   * @brief 获取角块位置的坐标
+   * @param corner 角块位置编号
+   * @return 整数坐标
+   */
+  static Vector3 cornerPosition(int corner);
+
+  /**
+   * @brief 获取棱块位置的坐标
+   * @param edge 棱块位置编号
+   * @return 整数坐标
+   */
+  static Vector3 edgePosition(int edge);
+
+  /**
+   * @brief 计算排列的字典序秩（Lehmer 码）
+   * @param perm 排列（元素为 0 到 n-1）
+   * @param n 元素个数（不超过12）
+   * @return 秩（0 到 n!-1）
+   */
+  static uint32_t rankPermutation(const uint8_t *perm, int n);
+
+  /**
+   * @brief 由字典序秩恢复排列
+   * @param rank 秩
+   * @param perm 输出的排列
+   * @param n 元素个数（不超过12）
+   * @return 排列的奇偶性（奇排列为1）
+   */
+  static int unrankPermutation(uint32_t rank, uint8_t *perm, int n);
+
+  /**
+   * @brief 计算排列的奇偶性
+   * @param perm 排列
+   * @param n 元素个数
+   * @return 奇排列返回1，偶排列返回0
+   */
+  static int permutationParity(const uint8_t *perm, int n);
+
+  bool operator==(const CubeState &other) const;
+  bool operator!=(const CubeState &other) const { return !(*this == other); }
+};
+
+#endif
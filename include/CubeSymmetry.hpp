@@ -0,0 +1,85 @@
+#ifndef CUBE_SYMMETRY_HPP
+#define CUBE_SYMMETRY_HPP
+
+#include "CubeState.hpp"
+#include "Move.hpp"
+
+/**
+ * @class CubeSymmetry
+ * @brief 魔方的48个对称（24个旋转 × 是否镜像）及其在块级状态上的共轭表
+ * @details 对称 s 的矩阵为 ±R(s mod 24)：编号 0-23 为 RotationGroup 中的旋转，
+ *          24-47 为旋转再复合中心反演（镜像）。共轭把状态整体"换个角度看"：
+ *          位置和块编号按同一空间变换重新标记，镜像时朝向方向取反。
+ *          互为共轭的状态到还原状态的距离相同，因此可以只存、只搜其代表元
+ */
+class CubeSymmetry {
+public:
+  static constexpr int COUNT = 48;   ///< 对称个数
+  static constexpr int IDENTITY = 0; ///< 恒等对称的编号
+
+  /**
+   * @brief 判断对称是否包含镜像
+   * @param symmetry 对称编号
+   * @return 镜像对称返回true
+   */
+  static bool isMirror(int symmetry) { return symmetry >= COUNT / 2; }
+
+  /**
+   * @brief 计算状态在对称下的共轭
+   * @param state 原状态
+   * @param symmetry 对称编号
+   * @return 共轭状态
+   */
+  static CubeState conjugate(const CubeState &state, int symmetry);
+
+  /**
+   * @brief 计算对称类的代表元（编码最小的共轭状态）
+   * @param state 原状态
+   * @param symmetry 可选，输出把原状态变为代表元的对称编号
+   * @return 代表元状态
+   */
+  static CubeState canonicalize(const CubeState &state,
+                                int *symmetry = nullptr);
+
+  /**
+   * @brief 计算对称类代表元的编码
+   * @details 先只比较角块坐标，仅对并列的对称再计算棱块坐标
+   * @param state 原状态
+   * @param symmetry 可选，输出把原状态变为代表元的对称编号
+   * @return 代表元的编码
+   */
+  static StateCode canonicalCode(const CubeState &state,
+                                 int *symmetry = nullptr);
+
+  /**
+   * @brief 计算转动在对称下的共轭：conjugate(X·m) = conjugate(X)·m'
+   * @param move 原转动
+   * @param symmetry 对称编号
+   * @return 共轭转动 m'
+   */
+  static Move conjugateMove(const Move &move, int symmetry);
+
+  /**
+   * @brief 求逆对称
+   * @param symmetry 对称编号
+   * @return 逆对称编号
+   */
+  static int inverse(int symmetry);
+
+  /**
+   * @brief 组合两个对称
+   * @param a 后执行的对称
+   * @param b 先执行的对称
+   * @return 满足 conjugate(conjugate(X, b), a) = conjugate(X, 结果) 的对称
+   */
+  static int multiply(int a, int b);
+
+  /**
+   * @brief 计算使状态保持不变的对称个数（状态自身的对称度）
+   * @param state 状态
+   * @return 稳定子群的大小（1-48）
+   */
+  static int stabilizerSize(const CubeState &state);
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef CURSES_RENDERER_HPP
+#define CURSES_RENDERER_HPP
+
+#include "Renderer.hpp"
+#include <map>
+
+/**
+ * @class CursesRenderer
+ * @brief 通过 ncurses 输出的后端（调用方负责 initscr/endwin）
+ * @details 只在主程序中编译，rubik_core 不依赖终端库
+ */
+class CursesRenderer : public Renderer {
+public:
+  const char *name() const override { return "curses"; }
+
+  void present(const CellBuffer &buffer) override;
+
+  void invalidate() override;
+
+  // ncurses 不是线程安全的，主线程同时在调用 getch()
+  bool supportsOutputThread() const override { return false; }
+
+private:
+  std::map<int, int> colorCache; ///< 256色索引对应的颜色对
+};
+
+#endif
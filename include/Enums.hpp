@@ -26,4 +26,197 @@ enum PieceType {
   PIECE_CENTER  ///< 中心块（6个）
 };
 
+/**
+ * @enum Face
+ * @brief 魔方面枚举（实际魔方面，不随视角变化）
+ * @note 顺序与 RubiksCube 中 "F", "B", "L", "R", "U", "D" 的遍历顺序一致
+ */
+enum Face {
+  FACE_F = 0, ///< 前面（z = -1，朝向相机）
+  FACE_B = 1, ///< 后面（z = 1）
+  FACE_L = 2, ///< 左面（x = -1）
+  FACE_R = 3, ///< 右面（x = 1）
+  FACE_U = 4, ///< 上面（y = 1）
+  FACE_D = 5  ///< 下面（y = -1）
+};
+
+/**
+ * @enum Corner
+ * @brief 角块位置（及其所在角块）编号，采用通用的 URF 顺序
+ * @note 每个名称的第一个字母是该角块的参考面（U 或 D）
+ */
+enum Corner {
+  CORNER_URF = 0, ///< 上-右-前
+  CORNER_UFL = 1, ///< 上-前-左
+  CORNER_ULB = 2, ///< 上-左-后
+  CORNER_UBR = 3, ///< 上-后-右
+  CORNER_DFR = 4, ///< 下-前-右
+  CORNER_DLF = 5, ///< 下-左-前
+  CORNER_DBL = 6, ///< 下-后-左
+  CORNER_DRB = 7  ///< 下-右-后
+};
+
+/**
+ * @enum Edge
+ * @brief 棱块位置（及其所在棱块）编号，采用通用的 UR 顺序
+ * @note 每个名称的第一个字母是该棱块的参考面
+ */
+enum Edge {
+  EDGE_UR = 0,  ///< 上-右
+  EDGE_UF = 1,  ///< 上-前
+  EDGE_UL = 2,  ///< 上-左
+  EDGE_UB = 3,  ///< 上-后
+  EDGE_DR = 4,  ///< 下-右
+  EDGE_DF = 5,  ///< 下-前
+  EDGE_DL = 6,  ///< 下-左
+  EDGE_DB = 7,  ///< 下-后
+  EDGE_FR = 8,  ///< 前-右
+  EDGE_FL = 9,  ///< 前-左
+  EDGE_BL = 10, ///< 后-左
+  EDGE_BR = 11  ///< 后-右
+};
+
+/**
+ * @enum PatternKind
+ * @brief 模式数据库种类
+ */
+enum PatternKind {
+  PATTERN_CORNERS = 0,    ///< 全部8个角块（8!·3^7 个状态）
+  PATTERN_EDGES_LOW = 1,  ///< 棱块 UR..DF 共6个（12!/6!·2^6 个状态）
+  PATTERN_EDGES_HIGH = 2, ///< 棱块 DL..BR 共6个（12!/6!·2^6 个状态）
+  PATTERN_KIND_COUNT = 3  ///< 种类数
+};
+
+/**
+ * @enum FrameStage
+ * @brief 一帧中分别计时的阶段
+ */
+enum FrameStage {
+  STAGE_ANIMATION = 0, ///< 推进模拟（update）
+  STAGE_GEOMETRY = 1,  ///< 计算面片、剔除、着色与投影
+  STAGE_SORT = 2,      ///< 面片按深度排序
+  STAGE_RASTER = 3,    ///< 多边形填充（drawPolygon）
+  STAGE_UI = 4,        ///< 绘制界面（drawUI）
+  STAGE_REFRESH = 5,   ///< 输出到终端（refresh）
+  STAGE_FRAME = 6,     ///< 整帧（不含帧间等待）
+  STAGE_COUNT = 7      ///< 阶段数
+};
+
+/**
+ * @enum FrameCounter
+ * @brief 按帧累计、换算为每秒速率的计数器
+ */
+enum FrameCounter {
+  COUNTER_INPUT_EVENTS = 0,    ///< 收到的输入事件
+  COUNTER_MOUSE_ROTATIONS = 1, ///< 鼠标拖动实际执行的旋转
+  COUNTER_DROPPED_FRAMES = 2,  ///< 输出线程来不及发送、被新帧替换的帧
+  COUNTER_COUNT = 3            ///< 计数器数
+};
+
+/**
+ * @enum QualityLevel
+ * @brief 画质档位，编号越大省下的工作越多，每一档都包含之前各档的简化
+ */
+enum QualityLevel {
+  QUALITY_FULL = 0,      ///< 完整画质
+  QUALITY_FLAT = 1,      ///< 不按光照着色，每种颜色固定一个色号
+  QUALITY_COARSE = 2,    ///< 按半分辨率光栅化，每个结果写满一个 2x2 格块
+  QUALITY_HALF_RATE = 3, ///< 每两帧只绘制一帧（模拟照常推进）
+  QUALITY_NO_PANEL = 4,  ///< 不绘制控制面板（面板区域留空）
+  QUALITY_COUNT = 5      ///< 档位数
+};
+
+/**
+ * @enum InputKey
+ * @brief 非字符按键的编号（与字符的 ASCII 码共用 InputEvent::key）
+ */
+enum InputKey {
+  INPUT_KEY_ESCAPE = 27, ///< ESC
+  INPUT_KEY_UP = 256,    ///< 上方向键
+  INPUT_KEY_DOWN = 257,  ///< 下方向键
+  INPUT_KEY_LEFT = 258,  ///< 左方向键
+  INPUT_KEY_RIGHT = 259  ///< 右方向键
+};
+
+/**
+ * @enum InputType
+ * @brief 输入事件类型
+ */
+enum InputType {
+  INPUT_KEY = 0,           ///< 按键
+  INPUT_MOUSE_PRESS = 1,   ///< 左键按下
+  INPUT_MOUSE_RELEASE = 2, ///< 左键松开
+  INPUT_MOUSE_MOVE = 3     ///< 鼠标移动
+};
+
+/**
+ * @enum SolveKind
+ * @brief 求解请求的用途
+ */
+enum SolveKind {
+  SOLVE_HINT = 0, ///< 提示：只播放解的第一步
+  SOLVE_FULL = 1  ///< 自动还原：播放整个解
+};
+
+/**
+ * @enum SolverMode
+ * @brief 提示与自动还原使用的求解方法
+ */
+enum SolverMode {
+  SOLVER_THISTLETHWAITE = 0, ///< Thistlethwaite 四阶段法（任意状态，非最优）
+  SOLVER_BIDIRECTIONAL = 1   ///< 双向广度优先搜索（最优，只适合十几步以内）
+};
+
+/**
+ * @enum ServerOpcode
+ * @brief 控制服务器请求的操作码（协议见 CubeProtocol.hpp）
+ */
+enum ServerOpcode {
+  OP_APPLY = 1,    ///< 执行一批转动（一次性结算，不播放动画）
+  OP_STATE = 2,    ///< 查询块级状态
+  OP_RESET = 3,    ///< 还原
+  OP_SCRAMBLE = 4, ///< 随机打乱
+  OP_SOLVE = 5     ///< 求解当前状态（只返回解，不执行）
+};
+
+/**
+ * @enum ServerStatus
+ * @brief 控制服务器响应的状态码
+ */
+enum ServerStatus {
+  STATUS_OK = 0,          ///< 成功
+  STATUS_BAD_REQUEST = 1, ///< 负载不合法（如转动编号越界）
+  STATUS_UNKNOWN_OP = 2   ///< 未知操作码
+};
+
+/**
+ * @enum FaceletKernel
+ * @brief 批量执行面块置换的实现，编号越大使用的指令集越新
+ */
+enum FaceletKernel {
+  KERNEL_SCALAR = 0, ///< 逐字节查表（任何平台）
+  KERNEL_SSSE3 = 1,  ///< 4 个 128 位寄存器，pshufb
+  KERNEL_AVX2 = 2,   ///< 2 个 256 位寄存器，vpshufb 加跨 128 位交换
+  KERNEL_AVX512 = 3, ///< 1 个 512 位寄存器，AVX-512 VBMI 的 vpermb
+  KERNEL_COUNT = 4   ///< 实现个数
+};
+
+/**
+ * @enum StateError
+ * @brief 导入魔方状态（面块字符串、块记号）时的校验结果
+ */
+enum StateError {
+  STATE_OK = 0,               ///< 合法状态
+  STATE_BAD_FORMAT = 1,       ///< 长度、分隔或字符不合法
+  STATE_BAD_CENTER = 2,       ///< 中心块不是 URFDLB 顺序
+  STATE_BAD_CORNER = 3,       ///< 某个角块位置的颜色组合不是任何角块
+  STATE_BAD_EDGE = 4,         ///< 某个棱块位置的颜色组合不是任何棱块
+  STATE_DUPLICATE_CORNER = 5, ///< 同一角块出现两次（另一角块缺失）
+  STATE_DUPLICATE_EDGE = 6,   ///< 同一棱块出现两次（另一棱块缺失）
+  STATE_TWIST = 7,            ///< 角块朝向之和不是3的倍数
+  STATE_FLIP = 8,             ///< 棱块翻转之和为奇数
+  STATE_PARITY = 9,           ///< 角块与棱块排列的奇偶性不同
+  STATE_ERROR_COUNT = 10      ///< 结果种类数
+};
+
 #endif
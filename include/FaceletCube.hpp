@@ -0,0 +1,141 @@
+#ifndef FACELET_CUBE_HPP
+#define FACELET_CUBE_HPP
+
+#include "CubeState.hpp"
+#include "Enums.hpp"
+#include "Move.hpp"
+#include "ThreadPool.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct FaceletCube
+ * @brief 贴纸（面块）级的魔方表示，供批量统计模拟使用
+ * @details 54 个贴纸按 URFDLB 顺序存放（每面 9 个，按行从左上到右下，
+ *          与通用的 54 字符面块字符串一致），每个贴纸存其颜色所属面在
+ *          URFDLB 中的序号（0-5）。数组按 64 字节对齐，末尾 10 字节填充
+ *          为0，一个魔方正好放进一个 512 位、两个 256 位或四个 128 位寄存器。
+ *          面转动是贴纸的置换：转动后 facelets[i] = 转动前 facelets[perm[i]]，
+ *          与 pshufb/vpermb 的语义相同。与交互用的 RubiksCube 无关
+ */
+struct alignas(64) FaceletCube {
+  static constexpr int FACELETS = 54; ///< 贴纸数
+  static constexpr int BYTES = 64;    ///< 含填充的字节数
+
+  /// 每个角块位置上三个贴纸的序号（顺序同 CubeState::CORNER_FACES）
+  static const uint8_t CORNER_FACELETS[8][3];
+  /// 每个棱块位置上两个贴纸的序号（顺序同 CubeState::EDGE_FACES）
+  static const uint8_t EDGE_FACELETS[12][2];
+
+  uint8_t facelets[BYTES]; ///< 贴纸颜色（0-5，按 URFDLB），其后为填充
+
+  /**
+   * @brief 构造函数，创建已还原的魔方
+   */
+  FaceletCube();
+
+  /**
+   * @brief 由块级状态生成贴纸
+   * @param state 块级状态
+   * @return 对应的贴纸表示
+   */
+  static FaceletCube fromState(const CubeState &state);
+
+  /**
+   * @brief 执行一次面转动（逐字节查表）
+   * @param move 面转动
+   */
+  void apply(const Move &move);
+
+  /**
+   * @brief 获取面转动的贴纸置换
+   * @param move 面转动
+   * @return 64 字节的置换（填充部分映射到自身）
+   */
+  static const uint8_t *permutation(const Move &move);
+
+  /**
+   * @brief 判断是否为还原状态
+   * @return 每面九个贴纸颜色都与中心相同时返回true
+   */
+  bool isSolved() const;
+
+  bool operator==(const FaceletCube &other) const;
+  bool operator!=(const FaceletCube &other) const { return !(*this == other); }
+};
+
+/**
+ * @class FaceletBatch
+ * @brief 对大量 FaceletCube 批量执行转动序列
+ * @details 每个魔方载入寄存器后连续执行整个序列再写回，每步转动是一组
+ *          预先算好的字节重排掩码。魔方按块分给线程池，块内由所选指令集的
+ *          实现处理；各实现的结果逐字节相同
+ */
+class FaceletBatch {
+public:
+  static constexpr size_t CHUNK = 4096; ///< 每个线程池任务处理的魔方数
+
+  /**
+   * @brief 当前 CPU 支持的最快实现
+   * @return 实现编号
+   */
+  static FaceletKernel bestKernel();
+
+  /**
+   * @brief 判断当前 CPU 与编译器是否支持某个实现
+   * @param kernel 实现编号
+   * @return 支持返回true
+   */
+  static bool isSupported(FaceletKernel kernel);
+
+  /**
+   * @brief 获取实现的名称
+   * @param kernel 实现编号
+   * @return 名称（"scalar", "ssse3", "avx2", "avx512"）
+   */
+  static const char *kernelName(FaceletKernel kernel);
+
+  /**
+   * @brief 对每个魔方执行同一个转动序列
+   * @param pool 线程池
+   * @param cubes 魔方数组
+   * @param count 魔方个数
+   * @param moves 转动序列
+   * @param moveCount 转动个数
+   * @param kernel 实现编号（须受支持）
+   */
+  static void applyAll(ThreadPool &pool, FaceletCube *cubes, size_t count,
+                       const Move *moves, size_t moveCount,
+                       FaceletKernel kernel = bestKernel());
+
+  /**
+   * @brief 对每个魔方执行各自的转动序列
+   * @param pool 线程池
+   * @param cubes 魔方数组
+   * @param count 魔方个数
+   * @param moveIndices 转动编号（Move::index()），第 i 个魔方的序列从
+   *        moveIndices[i * movesPerCube] 开始
+   * @param movesPerCube 每个魔方的转动个数
+   * @param kernel 实现编号（须受支持）
+   */
+  static void applyEach(ThreadPool &pool, FaceletCube *cubes, size_t count,
+                        const uint8_t *moveIndices, size_t movesPerCube,
+                        FaceletKernel kernel = bestKernel());
+
+private:
+  /**
+   * @brief 把魔方按块分给线程池执行
+   * @param pool 线程池
+   * @param cubes 魔方数组
+   * @param count 魔方个数
+   * @param moveIndices 转动编号
+   * @param moveCount 每个魔方的转动个数
+   * @param stride 相邻魔方的序列间隔（0 表示共用一个序列）
+   * @param kernel 实现编号
+   */
+  static void run(ThreadPool &pool, FaceletCube *cubes, size_t count,
+                  const uint8_t *moveIndices, size_t moveCount, size_t stride,
+                  FaceletKernel kernel);
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef FRAME_ARENA_HPP
+#define FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class FrameArena
+ * @brief 每帧复用的线性（bump）分配器
+ * @details 分配只移动游标，reset() 时整体回收，不逐个释放。当前块不够时
+ *          追加新块；reset() 会把多个块合并成一个足够大的块，所以经过
+ *          前几帧的增长后，稳定状态下不再向堆申请内存。
+ *          只能存放可平凡析构的类型，对象不会被析构
+ */
+class FrameArena {
+public:
+  /**
+   * @brief 构造函数
+   * @param blockSize 初始块大小（字节）
+   */
+  explicit FrameArena(size_t blockSize = 64 * 1024);
+
+  /**
+   * @brief 分配一段未初始化的内存
+   * @param bytes 字节数
+   * @param alignment 对齐（2的幂）
+   * @return 内存地址，在下一次 reset() 前有效
+   */
+  void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * @brief 分配并值初始化一个数组
+   * @tparam T 元素类型（必须可平凡析构）
+   * @param count 元素个数
+   * @return 数组首地址，在下一次 reset() 前有效
+   */
+  template <typename T> T *allocateArray(size_t count) {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "FrameArena never runs destructors");
+    T *items = static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    for (size_t i = 0; i < count; i++) {
+      new (items + i) T();
+    }
+    return items;
+  }
+
+  /**
+   * @brief 回收本帧的全部分配（每帧开始时调用）
+   */
+  void reset();
+
+  /**
+   * @brief 本帧已分配的字节数（含对齐填充）
+   * @return 字节数
+   */
+  size_t bytesUsed() const;
+
+  /**
+   * @brief 所有块的总容量
+   * @return 字节数
+   */
+  size_t capacity() const;
+
+  /**
+   * @brief 构造之后向堆申请新块（追加或合并）的次数
+   * @return 次数；稳定状态下每帧不再增加
+   */
+  size_t growCount() const { return grows; }
+
+private:
+  /**
+   * @struct Block
+   * @brief 一块连续内存
+   */
+  struct Block {
+    std::unique_ptr<unsigned char[]> data; ///< 内存
+    size_t size;                           ///< 大小（字节）
+  };
+
+  std::vector<Block> blocks; ///< 所有块，前面的块已用完
+  size_t current;            ///< 正在使用的块
+  size_t offset;             ///< 当前块中的游标
+  size_t used;               ///< 本帧已用完的前面各块的字节数
+  size_t grows;              ///< 构造之后申请新块的次数
+};
+
+#endif
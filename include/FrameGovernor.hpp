@@ -0,0 +1,114 @@
+#ifndef FRAME_GOVERNOR_HPP
+#define FRAME_GOVERNOR_HPP
+
+#include "Enums.hpp"
+#include <cstdint>
+
+/**
+ * @class FrameGovernor
+ * @brief 帧耗时预算：超预算时逐档降低画质，有余量时再逐档恢复
+ * @details 每 WINDOW 个绘制的帧判断一次：超过四分之一的帧超出预算（或被
+ *          输出线程丢弃）时降一档；连续 UP_WINDOWS 个窗口内每帧都不到预算
+ *          的一半时升一档。升档的门槛远低于降档，避免在两档之间来回切换。
+ *          默认不自动调整，固定为完整画质，无终端回放的结果不受机器快慢
+ *          影响
+ */
+class FrameGovernor {
+public:
+  static constexpr int WINDOW = 30;    ///< 每次判断的帧数（约半秒）
+  static constexpr int UP_WINDOWS = 4; ///< 升档前需要连续有余量的窗口数
+  static constexpr int HISTORY = 32;   ///< 保留的最近帧耗时个数
+
+  /**
+   * @brief 构造函数（固定为完整画质）
+   */
+  FrameGovernor();
+
+  /**
+   * @brief 开始按预算自动调整画质
+   * @param budgetMicros 每帧的耗时预算（微秒）
+   */
+  void setAdaptive(double budgetMicros);
+
+  /**
+   * @brief 固定画质档位（停止自动调整）
+   * @param level 档位
+   */
+  void setLevel(QualityLevel level);
+
+  /**
+   * @brief 是否在自动调整
+   * @return 自动调整时返回true
+   */
+  bool isAdaptive() const { return adaptive; }
+
+  /**
+   * @brief 当前画质档位
+   * @return 档位
+   */
+  QualityLevel level() const { return currentLevel; }
+
+  /**
+   * @brief 每帧的耗时预算
+   * @return 预算（微秒）
+   */
+  double budget() const { return budgetMicros; }
+
+  /**
+   * @brief 本帧是否跳过绘制（QUALITY_HALF_RATE 及以下每两帧绘制一帧）
+   * @param frame 帧序号
+   * @return 跳过时返回true
+   */
+  bool skipFrame(uint64_t frame) const {
+    return currentLevel >= QUALITY_HALF_RATE && frame % 2 != 0;
+  }
+
+  /**
+   * @brief 记录一个绘制的帧，必要时调整档位
+   * @param micros 这一帧的耗时（微秒）
+   * @param dropped 这一帧是否被输出线程丢弃
+   */
+  void record(double micros, bool dropped);
+
+  /**
+   * @brief 保留的帧耗时个数
+   * @return 个数（不超过 HISTORY）
+   */
+  int historySize() const { return historyCount; }
+
+  /**
+   * @brief 读取保留的帧耗时
+   * @param index 序号（0 为最早的一帧）
+   * @return 耗时（微秒）
+   */
+  float historyAt(int index) const {
+    return history[(historyCursor - historyCount + index + HISTORY) %
+                   HISTORY];
+  }
+
+  /**
+   * @brief 获取档位名称
+   * @param level 档位
+   * @return 名称，如 "flat"
+   */
+  static const char *levelName(QualityLevel level);
+
+private:
+  /**
+   * @brief 开始新的判断窗口
+   */
+  void resetWindow();
+
+  QualityLevel currentLevel; ///< 当前档位
+  bool adaptive;             ///< 是否自动调整
+  double budgetMicros;       ///< 每帧预算（微秒）
+  int windowFrames;          ///< 当前窗口已记录的帧数
+  int overBudget;            ///< 当前窗口超预算的帧数
+  bool windowBusy;           ///< 当前窗口有超过预算一半的帧
+  int quietWindows;          ///< 连续有余量的窗口数
+  float history[HISTORY];    ///< 最近的帧耗时（环形）
+  int historyCursor;         ///< 下一个写入位置
+  int historyCount;          ///< 有效个数
+};
+
+#endif
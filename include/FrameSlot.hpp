@@ -0,0 +1,61 @@
+#ifndef FRAME_SLOT_HPP
+#define FRAME_SLOT_HPP
+
+#include "CellBuffer.hpp"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class FrameSlot
+ * @brief 单生产者单消费者的无锁帧交接槽，只保留最新的一帧
+ * @details 共三个缓冲区：生产者正在绘制的一帧、消费者正在输出的一帧，
+ *          以及槽里等待交接的一帧。交接只是用原子交换调换缓冲区编号，
+ *          双方都不会阻塞；消费者来不及取走时，新帧直接替换槽里的旧帧
+ */
+class FrameSlot {
+public:
+  /**
+   * @brief 构造函数
+   */
+  FrameSlot();
+
+  /**
+   * @brief 生产者当前用于绘制的缓冲区（publish() 后会换成另一个）
+   * @return 缓冲区
+   */
+  CellBuffer &back() { return buffers[backIndex]; }
+
+  /**
+   * @brief 生产者交出绘制好的帧
+   * @return 槽里原有的帧还没被取走、因此被丢弃时返回true
+   */
+  bool publish();
+
+  /**
+   * @brief 消费者取出最新的帧
+   * @return 有新帧时返回true，之后 front() 即为该帧
+   */
+  bool acquire();
+
+  /**
+   * @brief 消费者最近取出的帧
+   * @return 缓冲区（消费者可以换走其内容，生产者每帧都会完整重绘）
+   */
+  CellBuffer &front() { return buffers[frontIndex]; }
+
+  /**
+   * @brief 槽里是否有尚未取走的帧
+   * @return 有新帧时返回true
+   */
+  bool pending() const { return (slot.load() & FRESH) != 0; }
+
+private:
+  static constexpr uint8_t FRESH = 4; ///< 槽里的帧尚未被取走
+
+  CellBuffer buffers[3];     ///< 三个缓冲区
+  int backIndex;             ///< 生产者的缓冲区（仅生产者访问）
+  int frontIndex;            ///< 消费者的缓冲区（仅消费者访问）
+  std::atomic<uint8_t> slot; ///< 槽里的缓冲区编号 | FRESH
+};
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef FRAME_STATS_HPP
+#define FRAME_STATS_HPP
+
+#include "Enums.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class FrameStats
+ * @brief 逐帧分阶段计时统计
+ * @details 每个阶段保留最近 WINDOW 帧的耗时用于滚动的 p50/p99/max，
+ *          另有覆盖整个运行期的对数分桶直方图（每个2的幂分8档），
+ *          用于退出时导出汇总。计数器按帧累计，同样在滚动窗口内换算为
+ *          每秒速率
+ */
+class FrameStats {
+public:
+  static constexpr int WINDOW = 240;    ///< 滚动窗口帧数（约4秒）
+  static constexpr int SUB_BUCKETS = 8; ///< 每个2的幂的细分档数
+  static constexpr int BUCKETS = 208;   ///< 直方图桶数（1µs 到约 67s）
+
+  /**
+   * @brief 构造函数
+   */
+  FrameStats();
+
+  /**
+   * @brief 记录一个阶段的一次耗时
+   * @param stage 阶段
+   * @param micros 耗时（微秒）
+   */
+  void record(FrameStage stage, double micros);
+
+  /**
+   * @brief 计算滚动窗口内的分位数
+   * @param stage 阶段
+   * @param fraction 分位（0-1，如0.99）
+   * @return 耗时（微秒），窗口为空时为0
+   */
+  double percentile(FrameStage stage, double fraction) const;
+
+  /**
+   * @brief 滚动窗口内的最大耗时
+   * @param stage 阶段
+   * @return 耗时（微秒）
+   */
+  double maximum(FrameStage stage) const;
+
+  /**
+   * @brief 累加当前帧的计数
+   * @param counter 计数器
+   * @param amount 增量
+   */
+  void count(FrameCounter counter, uint32_t amount = 1) {
+    pending[counter] += amount;
+  }
+
+  /**
+   * @brief 结束一帧：把当前帧的计数和帧间隔存入滚动窗口
+   * @param micros 与上一帧的间隔（微秒，含帧间等待）
+   */
+  void endFrame(double micros);
+
+  /**
+   * @brief 滚动窗口内计数器的每秒速率
+   * @param counter 计数器
+   * @return 每秒次数
+   */
+  double rate(FrameCounter counter) const;
+
+  /**
+   * @brief 滚动窗口内计数器单帧的最大值
+   * @param counter 计数器
+   * @return 单帧最大次数
+   */
+  uint32_t peakPerFrame(FrameCounter counter) const;
+
+  /**
+   * @brief 获取阶段名称
+   * @param stage 阶段
+   * @return 名称，如 "raster"
+   */
+  static const char *stageName(FrameStage stage);
+
+  /**
+   * @brief 把整个运行期的统计写入文本文件
+   * @param path 文件路径
+   * @return 写入成功返回true
+   */
+  bool writeReport(const std::string &path) const;
+
+  /**
+   * @brief 清空所有统计
+   */
+  void clear();
+
+private:
+  float samples[STAGE_COUNT][WINDOW];       ///< 最近的耗时（微秒）
+  int sampleCount[STAGE_COUNT];             ///< 窗口内有效样本数
+  int cursor[STAGE_COUNT];                  ///< 下一个写入位置
+  uint64_t histogram[STAGE_COUNT][BUCKETS]; ///< 全程直方图
+  uint64_t totalCount[STAGE_COUNT];         ///< 全程样本数
+  double totalMicros[STAGE_COUNT];          ///< 全程耗时之和
+  double totalMax[STAGE_COUNT];             ///< 全程最大耗时
+  uint32_t pending[COUNTER_COUNT];          ///< 当前帧的计数
+  uint32_t counts[COUNTER_COUNT][WINDOW];   ///< 最近各帧的计数
+  float intervals[WINDOW];                  ///< 最近各帧的间隔（微秒）
+  int frameCount;                           ///< 窗口内有效帧数
+  int frameCursor;                          ///< 下一个写入位置
+
+  static int bucketOf(double micros);
+  static double bucketUpper(int bucket);
+};
+
+/**
+ * @class ScopedTimer
+ * @brief 作用域计时器，析构时把经过的时间记入 FrameStats
+ */
+class ScopedTimer {
+public:
+  /**
+   * @brief 构造函数，开始计时
+   * @param stats 统计对象
+   * @param stage 阶段
+   */
+  ScopedTimer(FrameStats &stats, FrameStage stage)
+      : stats(stats), stage(stage), begin(std::chrono::steady_clock::now()) {}
+
+  ~ScopedTimer() {
+    stats.record(stage, std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - begin)
+                            .count());
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  FrameStats &stats;                           ///< 统计对象
+  FrameStage stage;                            ///< 阶段
+  std::chrono::steady_clock::time_point begin; ///< 开始时间
+};
+
+#endif
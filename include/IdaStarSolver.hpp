@@ -0,0 +1,138 @@
+#ifndef IDA_STAR_SOLVER_HPP
+#define IDA_STAR_SOLVER_HPP
+
+#include "CubeState.hpp"
+#include "Move.hpp"
+#include "PatternDatabase.hpp"
+#include "ThreadPool.hpp"
+#include "TranspositionTable.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct IdaIteration
+ * @brief IDA* 一轮迭代的记录
+ */
+struct IdaIteration {
+  int bound;           ///< 本轮的步数上限
+  uint64_t nodes;      ///< 展开的节点数
+  uint64_t tableHits;  ///< 被置换表剪掉的节点数
+  double milliseconds; ///< 耗时（毫秒）
+};
+
+/**
+ * @struct IdaStats
+ * @brief 一次求解的统计
+ */
+struct IdaStats {
+  std::vector<IdaIteration> iterations; ///< 各轮迭代
+  int startBound = 0;                   ///< 起始状态的下界
+  int prefixes = 0;                     ///< 前两步的组合数
+  int rootTasks = 0;                    ///< 去掉共轭重复后每轮的任务数
+};
+
+/**
+ * @class IdaStarSolver
+ * @brief 以模式数据库为下界的多线程 IDA* 最优求解器
+ * @details 启发函数取角块与两组棱块数据库（rubik_pdb 生成的4位表，
+ *          通过 mmap 加载）中的最大值：三者都是到还原状态步数的下界，
+ *          取最大仍是下界，因此找到的第一个解即最优解（半圈计一步）。
+ *          每轮迭代做深度优先搜索，剪去 已走步数 + 下界 超过本轮上限的
+ *          分支，并跳过同面连转和对面转动的重复顺序。
+ *          每轮把前两步的所有组合作为任务分给线程池，各线程共用一张
+ *          TranspositionTable：搜索失败的节点记下学到的更大下界，其他线程、
+ *          之后的迭代和之后的求解再到达同一节点时直接剪掉。
+ *          互为共轭（CubeSymmetry）的前缀剩余的最优步数相同，只保留一个
+ *          十几步以内的状态几秒内可解；随机状态（约18步）可能需要很久
+ */
+class IdaStarSolver {
+public:
+  static constexpr int MAX_DEPTH = 20; ///< 默认步数上限（任意状态不超过20步）
+  static constexpr size_t DEFAULT_TABLE_SLOTS = 1 << 21; ///< 默认置换表槽位数
+
+  /**
+   * @brief 构造函数（不加载表）
+   * @param threads 搜索线程数，不大于0时使用硬件并发数
+   * @param tableSlots 置换表槽位数（每个16字节）
+   */
+  explicit IdaStarSolver(int threads = 0,
+                         size_t tableSlots = DEFAULT_TABLE_SLOTS);
+
+  /**
+   * @brief 通过 mmap 加载角块与两组棱块的数据库
+   * @param directory rubik_pdb 的输出目录（corners.pdb、edges-low.pdb、
+   *        edges-high.pdb，每项4位）
+   * @return 三张表都加载并校验成功返回true
+   */
+  bool loadTables(const std::string &directory);
+
+  /**
+   * @brief 判断表是否可用
+   * @return 三张表都已加载返回true
+   */
+  bool isReady() const;
+
+  /**
+   * @brief 计算到还原状态步数的下界
+   * @param state 魔方状态
+   * @return 三张表中距离的最大值
+   */
+  int lowerBound(const CubeState &state) const;
+
+  /**
+   * @brief 求最优解
+   * @param state 魔方状态（须合法）
+   * @param solution 输出的转动序列
+   * @param maxDepth 只找不超过这么多步的解
+   * @param cancel 取消标志，置为true后尽快返回；为空时不检查
+   * @return 找到解返回true；表不可用、被取消或超过步数上限返回false
+   */
+  bool solve(const CubeState &state, std::vector<Move> &solution,
+             int maxDepth = MAX_DEPTH,
+             const std::atomic<bool> *cancel = nullptr);
+
+  /**
+   * @brief 获取最近一次求解的统计
+   * @return 统计
+   */
+  const IdaStats &lastStats() const { return stats; }
+
+  /**
+   * @brief 获取搜索线程数
+   * @return 线程数
+   */
+  int threadCount() const { return pool.size(); }
+
+  /**
+   * @brief 获取置换表槽位数
+   * @return 槽位数
+   */
+  size_t tableSlots() const { return table.capacity(); }
+
+private:
+  struct Worker; ///< 一个任务的搜索上下文（路径、计数、停止标志）
+
+  /**
+   * @brief 深度优先搜索一个节点
+   * @param state 当前状态
+   * @param remaining 本轮还能走的步数
+   * @param lastFace 上一步转动的面（-1 表示没有）
+   * @param worker 搜索上下文，找到解时其路径即完整的解
+   * @return 找到解时为 -1；否则为该节点（在不能先转 lastFace 的约束下）
+   *         到还原状态步数的下界，大于 remaining
+   */
+  int search(const CubeState &state, int remaining, int lastFace,
+             Worker &worker);
+
+  PatternDatabase corners;   ///< 角块数据库
+  PatternDatabase edgesLow;  ///< 棱块 UR..DF 数据库
+  PatternDatabase edgesHigh; ///< 棱块 DL..BR 数据库
+  ThreadPool pool;           ///< 搜索线程
+  TranspositionTable table;  ///< 各线程共用的置换表（跨求解保留）
+  IdaStats stats;            ///< 最近一次求解的统计
+};
+
+#endif
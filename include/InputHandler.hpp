@@ -0,0 +1,73 @@
+#ifndef INPUT_HANDLER_HPP
+#define INPUT_HANDLER_HPP
+
+#include "Enums.hpp"
+#include "RubiksCube.hpp"
+#include "SolverThread.hpp"
+
+/**
+ * @struct InputEvent
+ * @brief 与终端库无关的输入事件
+ */
+struct InputEvent {
+  InputType type; ///< 事件类型
+  int key;        ///< 按键（字符或 InputKey），仅 INPUT_KEY 有效
+  int x;          ///< 鼠标列，仅鼠标事件有效
+  int y;          ///< 鼠标行，仅鼠标事件有效
+};
+
+/**
+ * @class InputHandler
+ * @brief 把输入事件转换为对魔方的操作
+ * @details 交互运行和回放共用同一套处理逻辑，保证回放结果与实际操作一致。
+ *          在背景上拖动旋转整个魔方：鼠标移动只累加位移，由 flush() 每帧
+ *          合并成一次旋转；在贴纸上拖动则转动贴纸所在的层，每次按下只转
+ *          一次。按键依赖当前视角，处理按键前会先执行累积的旋转。
+ *          提示和自动还原交给后台求解线程，用户转动、重置或打乱魔方时
+ *          取消未完成的求解和尚未播放的解
+ */
+class InputHandler {
+public:
+  /**
+   * @brief 构造函数
+   * @param cube 被操作的魔方
+   * @param solver 后台求解线程，为空时忽略提示和自动还原按键
+   */
+  explicit InputHandler(RubiksCube &cube, SolverThread *solver = nullptr);
+
+  /**
+   * @brief 处理一个事件
+   * @param event 输入事件
+   * @return 请求退出时返回false
+   */
+  bool handle(const InputEvent &event);
+
+  /**
+   * @brief 把累积的拖动位移合并为一次旋转（每帧调用一次）
+   */
+  void flush();
+
+  /**
+   * @brief 把后台求解完成的解交给魔方以动画播放（每帧调用一次）
+   */
+  void applySolverResults();
+
+private:
+  /**
+   * @brief 魔方状态被用户改变：取消求解，停止播放之前的解
+   */
+  void cancelSolve();
+
+  RubiksCube &cube;     ///< 被操作的魔方
+  SolverThread *solver; ///< 后台求解线程（可为空）
+  bool dragging;        ///< 是否正在拖动
+  int prevX;            ///< 上次鼠标列
+  int prevY;            ///< 上次鼠标行
+  int pendingDx;        ///< 尚未执行的水平位移
+  int pendingDy;        ///< 尚未执行的垂直位移
+  int dragSticker;      ///< 按下时指针下的贴纸（0：拖动旋转整个魔方）
+  int pressX;           ///< 按下时的鼠标列
+  int pressY;           ///< 按下时的鼠标行
+};
+
+#endif
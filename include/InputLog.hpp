@@ -0,0 +1,63 @@
+#ifndef INPUT_LOG_HPP
+#define INPUT_LOG_HPP
+
+#include "InputHandler.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct InputRecord
+ * @brief 输入日志中的一条记录
+ */
+struct InputRecord {
+  uint64_t frame;   ///< 事件在第几帧开始时送入
+  InputEvent event; ///< 事件
+};
+
+/**
+ * @class InputLog
+ * @brief 输入事件日志的读写
+ * @details 文本格式，每行一条，'#' 开头为注释：
+ *          - "seed <n>"：打乱用的随机种子
+ *          - "<frame> key <k>"：k 为单个字符，或 esc/up/down/left/right
+ *          - "<frame> press|release|move <x> <y>"：鼠标事件
+ */
+class InputLog {
+public:
+  /**
+   * @brief 构造函数（不打开文件）
+   */
+  InputLog();
+
+  /**
+   * @brief 读取整个日志
+   * @param path 文件路径
+   * @param records 读出的记录（按帧号排序）
+   * @param seed 读出的随机种子（日志中没有时保持不变）
+   * @return 读取成功返回true，格式错误时返回false
+   */
+  static bool load(const std::string &path, std::vector<InputRecord> &records,
+                   uint32_t &seed);
+
+  /**
+   * @brief 创建日志文件用于记录
+   * @param path 文件路径
+   * @param seed 随机种子
+   * @return 创建成功返回true
+   */
+  bool create(const std::string &path, uint32_t seed);
+
+  /**
+   * @brief 追加一条记录（未打开文件时忽略）
+   * @param frame 帧号
+   * @param event 事件
+   */
+  void append(uint64_t frame, const InputEvent &event);
+
+private:
+  std::ofstream out; ///< 记录用的输出流
+};
+
+#endif
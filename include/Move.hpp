@@ -0,0 +1,95 @@
+#ifndef MOVE_HPP
+#define MOVE_HPP
+
+#include "Enums.hpp"
+#include "Vector3.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct Move
+ * @brief 表示一次面转动（实际魔方面 + 顺时针四分之一圈数）
+ * @details 顺时针的定义与 RubiksCube::rotateViewDirection 一致：
+ *          绕该面旋转轴（朝外法线）转动 +90 度
+ */
+struct Move {
+  uint8_t face;  ///< 转动的面（Face 枚举值）
+  uint8_t turns; ///< 顺时针四分之一圈数：1 顺时针，2 半圈，3 逆时针
+
+  /// 面转动总数（6个面 × 3种圈数）
+  static constexpr int COUNT = 18;
+
+  /**
+   * @brief 构造函数，创建面转动
+   * @param face 转动的面，默认为前面
+   * @param turns 顺时针四分之一圈数，默认为1
+   */
+  Move(Face face = FACE_F, int turns = 1)
+      : face(static_cast<uint8_t>(face)),
+        turns(static_cast<uint8_t>(((turns % 4) + 4) % 4)) {}
+
+  /**
+   * @brief 获取转动在 0-17 范围内的编号（face * 3 + turns - 1）
+   * @return 转动编号
+   */
+  int index() const { return face * 3 + turns - 1; }
+
+  /**
+   * @brief 根据编号创建转动
+   * @param index 转动编号（0-17）
+   * @return 对应的转动
+   */
+  static Move fromIndex(int index) {
+    return Move(static_cast<Face>(index / 3), index % 3 + 1);
+  }
+
+  /**
+   * @brief 获取逆转动
+   * @return 抵消本转动的转动
+   */
+  Move inverse() const { return Move(static_cast<Face>(face), 4 - turns); }
+
+  /**
+   * @brief 将转动转换为标准记号（如 "F", "U2", "R'"）
+   * @return 转动记号
+   */
+  std::string toString() const;
+
+  /**
+   * @brief 获取面的旋转轴（朝外法线）
+   * @param face 面
+   * @return 旋转轴向量
+   */
+  static Vector3 faceAxis(Face face);
+
+  /**
+   * @brief 获取面的名称
+   * @param face 面
+   * @return 面名称（"F", "B", "L", "R", "U", "D"）
+   */
+  static const char *faceName(Face face);
+
+  /**
+   * @brief 根据面名称查找面
+   * @param name 面名称（"F", "B", "L", "R", "U", "D"）
+   * @param face 输出的面
+   * @return 名称有效时返回true
+   */
+  static bool faceFromName(const std::string &name, Face &face);
+
+  /**
+   * @brief 解析以空格分隔的转动序列（如 "R U R' U'"）
+   * @param text 转动序列文本
+   * @param moves 输出的转动序列（追加）
+   * @return 全部解析成功返回true
+   */
+  static bool parseSequence(const std::string &text, std::vector<Move> &moves);
+
+  bool operator==(const Move &other) const {
+    return face == other.face && turns == other.turns;
+  }
+  bool operator!=(const Move &other) const { return !(*this == other); }
+};
+
+#endif
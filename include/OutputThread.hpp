@@ -0,0 +1,91 @@
+#ifndef OUTPUT_THREAD_HPP
+#define OUTPUT_THREAD_HPP
+
+#include "AsciicastRecorder.hpp"
+#include "FrameSlot.hpp"
+#include "Renderer.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class OutputThread
+ * @brief 在独立线程上输出帧，主线程同时准备下一帧
+ * @details 主线程绘制到 frame()，submit() 通过 FrameSlot 无锁交出；输出
+ *          线程每次只发送最新的一帧，来不及发送的旧帧被丢弃，终端写得慢
+ *          不会拖住输入处理。互斥量只用于空闲时的睡眠和唤醒，不参与帧的
+ *          交接。Renderer 的所有调用都在输出线程上进行（waitIdle() 之后
+ *          除外）
+ */
+class OutputThread {
+public:
+  /**
+   * @brief 构造函数，启动输出线程
+   * @param renderer 输出后端
+   */
+  explicit OutputThread(Renderer &renderer);
+
+  /**
+   * @brief 析构函数，结束输出线程（未发送的帧被丢弃）
+   */
+  ~OutputThread();
+
+  OutputThread(const OutputThread &) = delete;
+  OutputThread &operator=(const OutputThread &) = delete;
+
+  /**
+   * @brief 主线程用于绘制下一帧的缓冲区（submit() 后会换成另一个）
+   * @return 缓冲区
+   */
+  CellBuffer &frame() { return slot.back(); }
+
+  /**
+   * @brief 输出每帧之后把它交给录像（在第一次 submit() 之前调用）
+   * @param recorder 录像；为空时不录制
+   * @param start 录像时间戳的零点
+   */
+  void setRecorder(AsciicastRecorder *recorder,
+                   std::chrono::steady_clock::time_point start);
+
+  /**
+   * @brief 交出绘制好的帧并唤醒输出线程
+   * @return 上一帧还没发送、因此被丢弃时返回true
+   */
+  bool submit();
+
+  /**
+   * @brief 等待已交出的帧全部输出完（之后主线程可以直接操作终端）
+   */
+  void waitIdle();
+
+  /**
+   * @brief 已输出的帧数
+   * @return 帧数
+   */
+  uint64_t presented() const { return presentedFrames.load(); }
+
+private:
+  /**
+   * @brief 输出线程主循环
+   */
+  void run();
+
+  using Clock = std::chrono::steady_clock; ///< 录像时间戳用的时钟
+
+  Renderer &renderer;                    ///< 输出后端
+  FrameSlot slot;                        ///< 帧交接槽
+  std::mutex mutex;                      ///< 保护 busy、stopping
+  std::condition_variable wake;          ///< 有新帧或需要结束
+  std::condition_variable idle;          ///< 输出线程空闲
+  bool busy;                             ///< 输出线程正在输出
+  bool stopping;                         ///< 析构中
+  std::atomic<uint64_t> presentedFrames; ///< 已输出的帧数
+  AsciicastRecorder *recorder;           ///< 录像（只在输出线程上调用）
+  Clock::time_point recordStart;         ///< 录像时间戳的零点
+  std::thread thread;                    ///< 输出线程（最后构造）
+};
+
+#endif
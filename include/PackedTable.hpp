@@ -0,0 +1,99 @@
+#ifndef PACKED_TABLE_HPP
+#define PACKED_TABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class PackedTable
+ * @brief 按位压缩的定长表（每项2位或4位），存放在64位原子字中
+ * @details 新表所有项均为 empty()（全1）。claim() 用 compare_exchange
+ *          把空项改成指定值，已有值的项不会被覆盖，
+ *          多个线程可以无锁地共同填表
+ */
+class PackedTable {
+public:
+  /**
+   * @brief 构造函数，分配并把所有项置为空
+   * @param entryCount 项数
+   * @param bitsPerEntry 每项位数（2或4）
+   */
+  PackedTable(uint64_t entryCount, int bitsPerEntry);
+
+  /**
+   * @brief 读取一项
+   * @param index 项编号
+   * @return 项的值
+   */
+  int get(uint64_t index) const {
+    uint64_t word =
+        words[index / entriesPerWord].load(std::memory_order_relaxed);
+    return static_cast<int>((word >> shiftOf(index)) & valueMask);
+  }
+
+  /**
+   * @brief 若该项为空则原子地写入值
+   * @param index 项编号
+   * @param value 要写入的值（小于 empty()）
+   * @return 该项原本为空（即由本次调用写入）时返回true
+   */
+  bool claim(uint64_t index, int value) {
+    std::atomic<uint64_t> &word = words[index / entriesPerWord];
+    int shift = shiftOf(index);
+    uint64_t clear = (valueMask & ~static_cast<uint64_t>(value)) << shift;
+    uint64_t old = word.load(std::memory_order_relaxed);
+    while (((old >> shift) & valueMask) == valueMask) {
+      if (word.compare_exchange_weak(old, old & ~clear,
+                                     std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief 获取表示"空"的值
+   * @return 空值（2位表为3，4位表为15）
+   */
+  int empty() const { return static_cast<int>(valueMask); }
+
+  /**
+   * @brief 获取项数
+   * @return 项数
+   */
+  uint64_t size() const { return entryCount; }
+
+  /**
+   * @brief 获取每项位数
+   * @return 2或4
+   */
+  int bits() const { return bitsPerEntry; }
+
+  /**
+   * @brief 获取原始字数组（仅在没有并发写入时使用）
+   * @return 字数组首地址
+   */
+  const uint64_t *data() const;
+
+  /**
+   * @brief 获取字数
+   * @return 字数
+   */
+  size_t wordCount() const { return wordTotal; }
+
+private:
+  std::unique_ptr<std::atomic<uint64_t>[]> words; ///< 存储字
+  uint64_t entryCount;                            ///< 项数
+  size_t wordTotal;                               ///< 字数
+  int bitsPerEntry;                               ///< 每项位数
+  int entriesPerWord;                             ///< 每个字的项数
+  uint64_t valueMask;                             ///< 单项掩码
+
+  int shiftOf(uint64_t index) const {
+    return static_cast<int>(index % entriesPerWord) * bitsPerEntry;
+  }
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef PATTERN_DATABASE_HPP
+#define PATTERN_DATABASE_HPP
+
+#include "CubeState.hpp"
+#include "Enums.hpp"
+#include "PackedTable.hpp"
+#include "TableBuilder.hpp"
+#include "TableFile.hpp"
+#include <memory>
+#include <string>
+
+/**
+ * @class PatternDatabase
+ * @brief 3x3 魔方的模式数据库（角块或6个棱块的子集）
+ * @details 只看一部分块时，到还原状态的最少步数是整个魔方步数的下界，
+ *          可以作为 IDA* 等搜索的启发函数。每项4位时直接存储距离；
+ *          每项2位时存储距离 mod 3，体积减半，但查询时需要已知
+ *          父状态的距离（两者相差不超过1）
+ */
+class PatternDatabase {
+public:
+  /**
+   * @brief 构造函数（不生成表）
+   * @param kind 数据库种类
+   * @param bitsPerEntry 每项位数（4：直接存距离；2：存距离 mod 3）
+   */
+  explicit PatternDatabase(PatternKind kind, int bitsPerEntry = 4);
+
+  /**
+   * @brief 用多线程广度优先搜索生成表
+   * @param threads 线程数，不大于0时使用全部硬件线程
+   * @return 统计信息（每层状态数和耗时）
+   */
+  BuildStats generate(int threads = 0);
+
+  /**
+   * @brief 将表保存到文件
+   * @param path 文件路径
+   * @return 保存成功返回true
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * @brief 通过 mmap 加载表
+   * @param path 文件路径
+   * @return 加载并校验成功返回true
+   */
+  bool load(const std::string &path);
+
+  /**
+   * @brief 判断表是否可用
+   * @return 已生成或已加载返回true
+   */
+  bool isReady() const { return words != nullptr; }
+
+  /**
+   * @brief 计算状态在该数据库中的编号
+   * @param state 魔方状态
+   * @return 编号（0 为还原状态）
+   */
+  uint64_t indexOf(const CubeState &state) const;
+
+  /**
+   * @brief 读取原始表项
+   * @param index 编号
+   * @return 4位表为距离，2位表为距离 mod 3
+   */
+  int valueAt(uint64_t index) const {
+    int perWord = 64 / bits;
+    int shift = static_cast<int>(index % perWord) * bits;
+    return static_cast<int>((words[index / perWord] >> shift) &
+                            ((1u << bits) - 1));
+  }
+
+  /**
+   * @brief 查询距离下界（仅限4位表）
+   * @param state 魔方状态
+   * @return 距离；表不可用或为2位表时返回-1
+   */
+  int distance(const CubeState &state) const;
+
+  /**
+   * @brief 由父状态的距离还原子状态的距离（适用于两种表）
+   * @param state 子状态
+   * @param parentDistance 父状态（与子状态相差一步）的距离
+   * @return 距离；表不可用时返回-1
+   */
+  int distance(const CubeState &state, int parentDistance) const;
+
+  /**
+   * @brief 获取种类
+   * @return 数据库种类
+   */
+  PatternKind kind() const { return patternKind; }
+
+  /**
+   * @brief 获取每项位数
+   * @return 2或4
+   */
+  int bitsPerEntry() const { return bits; }
+
+  /**
+   * @brief 获取表数据字节数
+   * @return 字节数
+   */
+  size_t tableBytes() const;
+
+  /**
+   * @brief 获取某种数据库的项数
+   * @param kind 数据库种类
+   * @return 项数
+   */
+  static uint64_t entryCount(PatternKind kind);
+
+  /**
+   * @brief 获取某种数据库的名称（同时写入文件头）
+   * @param kind 数据库种类
+   * @return 名称，如 "corners"
+   */
+  static const char *name(PatternKind kind);
+
+private:
+  PatternKind patternKind;                ///< 数据库种类
+  int bits;                               ///< 每项位数
+  std::unique_ptr<PackedTable> generated; ///< 生成的表
+  TableFile mapped;                       ///< 映射的表文件
+  const uint64_t *words;                  ///< 当前使用的表数据
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef PIECE_TRANSFORM_HPP
+#define PIECE_TRANSFORM_HPP
+
+#include "Move.hpp"
+#include "Vector3.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class PieceTransform
+ * @brief 一段转动序列对所有块位置的整体作用（块置换 + 每块的旋转）
+ * @details 位置按 (x+1)*9 + (y+1)*3 + (z+1) 编号为 0-26（13 为不动的核心）。
+ *          对每个起始位置，记录从该位置出发的块最终所在位置以及累计的
+ *          RotationGroup 旋转，因此任意长的序列都可以先在整数表上组合，
+ *          最后对每个块只做一次姿态更新
+ */
+class PieceTransform {
+public:
+  static constexpr int SLOT_COUNT = 27; ///< 位置总数（含核心）
+
+  /**
+   * @brief 构造函数，创建恒等变换
+   */
+  PieceTransform();
+
+  /**
+   * @brief 在当前变换之后追加一次面转动
+   * @param move 面转动
+   */
+  void apply(const Move &move);
+
+  /**
+   * @brief 将整段转动序列组合为一个变换
+   * @param moves 转动序列首地址
+   * @param count 转动个数
+   * @return 组合后的变换
+   */
+  static PieceTransform fromMoves(const Move *moves, size_t count);
+
+  /**
+   * @brief 获取从指定位置出发的块最终所在的位置
+   * @param slot 起始位置编号
+   * @return 最终位置编号
+   */
+  int targetOf(int slot) const { return target[slot]; }
+
+  /**
+   * @brief 获取从指定位置出发的块累计的旋转
+   * @param slot 起始位置编号
+   * @return RotationGroup 旋转编号
+   */
+  int turnAt(int slot) const { return turn[slot]; }
+
+  /**
+   * @brief 根据坐标计算位置编号（坐标四舍五入到 -1、0、1）
+   * @param position 块的坐标
+   * @return 位置编号（0-26）
+   */
+  static int slotIndex(const Vector3 &position);
+
+  /**
+   * @brief 获取位置编号对应的坐标
+   * @param slot 位置编号
+   * @return 整数坐标
+   */
+  static Vector3 slotPosition(int slot);
+
+private:
+  uint8_t target[SLOT_COUNT]; ///< 每个起始位置的最终位置
+  uint8_t turn[SLOT_COUNT];   ///< 每个起始位置的累计旋转
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include "CellBuffer.hpp"
+#include <cstdint>
+
+/**
+ * @class Renderer
+ * @brief 把离屏缓冲区输出到某个目标的后端接口
+ * @details 渲染代码只写 CellBuffer，输出方式（ncurses、直接写 ANSI
+ *          转义序列、不输出）在启动时选择
+ */
+class Renderer {
+public:
+  virtual ~Renderer() {}
+
+  /**
+   * @brief 后端名称
+   * @return 名称（与命令行 --renderer 的取值相同）
+   */
+  virtual const char *name() const = 0;
+
+  /**
+   * @brief 输出一帧
+   * @param buffer 离屏缓冲区
+   */
+  virtual void present(const CellBuffer &buffer) = 0;
+
+  /**
+   * @brief 屏幕被其他代码改写过，下一帧需要完整重绘
+   */
+  virtual void invalidate() {}
+
+  /**
+   * @brief 累计输出的字节数（不直接写字节的后端为0）
+   * @return 字节数
+   */
+  virtual uint64_t bytesWritten() const { return 0; }
+
+  /**
+   * @brief 能否在主线程以外的线程上调用 present()
+   * @return 可以时返回true
+   */
+  virtual bool supportsOutputThread() const { return true; }
+};
+
+/**
+ * @class NullRenderer
+ * @brief 不输出任何内容的后端，只统计帧数和格子数，用于基准测试
+ */
+class NullRenderer : public Renderer {
+public:
+  NullRenderer() : frameCount(0), cellCount(0) {}
+
+  const char *name() const override { return "null"; }
+
+  void present(const CellBuffer &buffer) override {
+    frameCount++;
+    cellCount += static_cast<uint64_t>(buffer.width()) * buffer.height();
+  }
+
+  /**
+   * @brief 已输出的帧数
+   * @return 帧数
+   */
+  uint64_t frames() const { return frameCount; }
+
+  /**
+   * @brief 已输出的格子总数
+   * @return 格子数
+   */
+  uint64_t cells() const { return cellCount; }
+
+private:
+  uint64_t frameCount; ///< 帧数
+  uint64_t cellCount;  ///< 格子数
+};
+
+#endif
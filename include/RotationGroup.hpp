@@ -0,0 +1,85 @@
+#ifndef ROTATION_GROUP_HPP
+#define ROTATION_GROUP_HPP
+
+#include "Enums.hpp"
+#include "Quaternion.hpp"
+#include "Vector3.hpp"
+#include <array>
+#include <cstdint>
+
+/**
+ * @class RotationGroup
+ * @brief 立方体的24个旋转（正八面体旋转群），以整数矩阵精确表示
+ * @details 每个魔方块的姿态都是该群中的一个元素，
+ *          因此块的位置和朝向可以用 0-23 的编号无误差地描述和组合
+ */
+class RotationGroup {
+public:
+  static constexpr int SIZE = 24;    ///< 群元素个数
+  static constexpr int IDENTITY = 0; ///< 恒等旋转的编号
+
+  /// 乘法表类型：PRODUCT[a][b] 表示先做 b 再做 a
+  using ProductTable = std::array<std::array<uint8_t, SIZE>, SIZE>;
+
+  /**
+   * @brief 组合两个旋转（与 Quaternion::multiply 的顺序一致）
+   * @param a 后执行的旋转
+   * @param b 先执行的旋转
+   * @return 组合后的旋转编号
+   */
+  static int multiply(int a, int b) { return productTable()[a][b]; }
+
+  /**
+   * @brief 获取乘法表（供热点循环直接查表）
+   * @return 24×24乘法表
+   */
+  static const ProductTable &productTable();
+
+  /**
+   * @brief 求逆旋转
+   * @param r 旋转编号
+   * @return 逆旋转编号
+   */
+  static int inverse(int r);
+
+  /**
+   * @brief 用旋转变换向量（整数矩阵乘法，对整数坐标无误差）
+   * @param r 旋转编号
+   * @param vec 要变换的向量
+   * @return 变换后的向量
+   */
+  static Vector3 apply(int r, const Vector3 &vec);
+
+  /**
+   * @brief 获取旋转对应的单位四元数
+   * @param r 旋转编号
+   * @return 四元数
+   */
+  static const Quaternion &quaternion(int r);
+
+  /**
+   * @brief 查找与四元数最接近的群元素（容忍浮点累积误差）
+   * @param q 四元数
+   * @return 旋转编号
+   */
+  static int fromQuaternion(const Quaternion &q);
+
+  /**
+   * @brief 获取面转动对应的旋转
+   * @param face 转动的面
+   * @param turns 顺时针四分之一圈数
+   * @return 旋转编号
+   */
+  static int faceTurn(Face face, int turns);
+
+  /**
+   * @brief 获取旋转的整数矩阵元素
+   * @param r 旋转编号
+   * @param row 行（0-2）
+   * @param col 列（0-2）
+   * @return 矩阵元素（-1、0或1）
+   */
+  static int matrix(int r, int row, int col);
+};
+
+#endif
@@ -1,24 +1,26 @@
 #ifndef RUBIKSCUBE_HPP
 #define RUBIKSCUBE_HPP
 
+#include "CellBuffer.hpp"
 #include "ColorConverter.hpp"
+#include "CubeState.hpp"
 #include "Enums.hpp" // 包含枚举定义
+#include "FrameArena.hpp"
+#include "FrameGovernor.hpp"
+#include "FrameStats.hpp"
+#include "Move.hpp"
 #include "RubiksCubePiece.hpp"
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
+#include <random>
 #include <vector>
 
-#ifdef _WIN32
-#include <pdcurses.h>
-#else
-#include <curses.h>
-#endif
-
 /**
  * @class RubiksCube
  * @brief 3x3魔方类，管理所有魔方块并提供渲染和交互功能
- * @details 使用四元数进行旋转，支持3D投影到终端显示
+ * @details 使用四元数进行旋转，支持3D投影到离屏字符缓冲区
  */
 class RubiksCube {
 private:
@@ -34,21 +36,57 @@ private:
 
   // Animation
   bool animating;          ///< 是否正在进行动画
+  int animationTicks;      ///< 动画已进行的模拟步数
   float animationProgress; ///< 动画进度（0-1）
+  float previousProgress;  ///< 上一模拟步的动画进度（用于插值）
   std::tuple<Vector3, std::string, bool>
       currentAnimation; ///< 当前动画信息（轴，面，方向）
-  std::chrono::steady_clock::time_point animationStartTime; ///< 动画开始时间
   std::vector<std::shared_ptr<RubiksCubePiece>>
       animationPieces;          ///< 动画涉及的块
   Quaternion animationRotation; ///< 动画旋转四元数
 
+  // Simulation
+  std::chrono::nanoseconds accumulator; ///< 尚未模拟的时间
+  float interpolation; ///< 渲染时在上两个模拟步之间的插值系数（0-1）
+
+  std::mt19937 random; ///< 打乱用的随机数发生器
+
+  std::deque<Move> moveQueue; ///< 等待以动画播放的转动（都拆成四分之一圈）
+
   // View mapping
-  std::map<std::string, std::string>
-      viewMapping;                               ///< 视图方向到实际魔方面的映射
-  std::map<std::string, Vector3> viewDirections; ///< 视图方向向量
+  Face viewFaces[6];     ///< 各视图方向（按 Face 顺序）当前对应的实际魔方面
+  bool viewMappingDirty; ///< rotation 改变后映射尚未重新计算
+
+  // Frame timing
+  FrameStats frameStats;  ///< 分阶段帧耗时统计
+  FrameGovernor governor; ///< 帧耗时预算与画质档位
+  bool showStats;         ///< 是否显示耗时面板
+  bool showUI;            ///< 是否绘制标题、控制面板等界面
+
+  FrameArena frameArena; ///< 渲染临时数据用的分配器，每帧开始时回收
+
+  // UI panel layer
+  CellBuffer uiPanel;    ///< 控制面板图层，只在内容变化时重新绘制
+  Face uiPanelFaces[6];  ///< 面板上显示的视图映射
+  int uiPanelScale;      ///< 面板上显示的缩放
+  bool uiPanelAnimating; ///< 面板上显示的动画状态
+  bool uiPanelValid;     ///< 面板图层是否已绘制
+  int uiPanelX;          ///< 本帧面板左上角列（屏幕放不下时为 -1）
+  int uiPanelY;          ///< 本帧面板左上角行
+
+  // Sticker picking
+  std::vector<uint8_t> pickBuffer; ///< 上一帧每个格子上的贴纸编号（0：无）
+  int pickWidth;                   ///< pickBuffer 的宽度（上一帧的画面宽度）
+  int pickHeight;                  ///< pickBuffer 的高度
 
   // Constants
   static constexpr float ANIMATION_DURATION = 0.3f; ///< 动画持续时间（秒）
+  static constexpr int TICK_RATE = 120;             ///< 每秒模拟步数
+  static constexpr int MAX_POLYGON_POINTS = 4;      ///< 贴纸多边形的最大顶点数
+  static constexpr int ANIMATION_TICKS =
+      static_cast<int>(ANIMATION_DURATION * TICK_RATE + 0.5f); ///< 动画步数
+  static constexpr std::chrono::nanoseconds MAX_CATCH_UP{
+      250000000}; ///< 单次 update 最多补算的时间，避免卡顿后无限追赶
   static constexpr float ROTATION_ANGLE =
       3.14159265359f / 2.0f; ///< 单次旋转角度（90度）
 
@@ -66,14 +104,38 @@ private:
 
   /**
    * @brief 更新视图映射（根据当前旋转确定哪个面朝前等）
+   * @details 视图方向都是坐标轴，与魔方各面法线的点积就是魔方坐标轴在
+   *          世界坐标系中的分量，取绝对值最大的分量即可；相对的视图方向
+   *          直接取相对的面
    */
   void updateViewMapping();
 
+  /**
+   * @brief 获取视图方向当前对应的实际魔方面（映射过期时先重新计算）
+   * @param view 视图方向
+   * @return 实际魔方面
+   */
+  Face viewFace(Face view) {
+    if (viewMappingDirty) {
+      updateViewMapping();
+    }
+    return viewFaces[view];
+  }
+
   /**
    * @brief 完成当前动画，更新块状态
    */
   void completeAnimation();
 
+  /**
+   * @brief 获取用于渲染的动画进度（在上两个模拟步之间插值）
+   * @return 进度（0-1）
+   */
+  float displayedProgress() const {
+    return previousProgress +
+           (animationProgress - previousProgress) * interpolation;
+  }
+
   /**
    * @brief 获取指定面上的所有块
    * @param faceChar 面字符（"F", "B", "L", "R", "U", "D"）
@@ -102,11 +164,12 @@ private:
    * @brief 获取块指定面的角点坐标（世界坐标系）
    * @param piece 块指针
    * @param faceName 面名称
-   * @return 角点坐标向量
+   * @param corners 输出的角点（至少 MAX_POLYGON_POINTS 个）
+   * @return 角点个数
    */
-  std::vector<Vector3>
-  getPieceFaceCorners(const std::shared_ptr<RubiksCubePiece> &piece,
-                      const std::string &faceName) const;
+  int getPieceFaceCorners(const std::shared_ptr<RubiksCubePiece> &piece,
+                          const std::string &faceName,
+                          Vector3 *corners) const;
 
   /**
    * @brief 根据法线计算亮度
@@ -126,22 +189,74 @@ private:
                                            int height) const;
 
   /**
-   * @brief 在终端上绘制填充多边形
-   * @param win ncurses窗口指针
-   * @param points 多边形顶点坐标
-   * @param colorPair 颜色对索引
+   * @brief 在缓冲区上绘制填充的凸多边形
+   * @details 从最高顶点出发沿左右两条边链逐行推进，每行整段填充，
+   *          不做堆分配。覆盖 y 在 [最高点, 最低点) 之间的行。
+   *          cellSize 为 2 时按半分辨率光栅化：顶点是 2x2 格块的坐标，
+   *          边链只走一半的行，每段扫描线写满对应的 2x2 块
+   * @param buffer 目标缓冲区
+   * @param points 多边形顶点坐标（按边的顺序，以格块为单位）
+   * @param count 顶点数
+   * @param color 终端256色索引
+   * @param colorChar 表示颜色的字符
+   * @param sticker 贴纸编号，同时写入 pickBuffer
+   * @param cellSize 格块边长（1 或 2）
+   */
+  void drawPolygon(CellBuffer &buffer, const std::pair<int, int> *points,
+                   int count, int color, char colorChar, uint8_t sticker,
+                   int cellSize = 1);
+
+  /**
+   * @brief 填充多边形的一段扫描线，跳过控制面板覆盖的区域
+   * @param buffer 目标缓冲区
+   * @param y 行
+   * @param x0 起始列（含）
+   * @param x1 结束列（含）
+   * @param color 终端256色索引
    * @param colorChar 表示颜色的字符
+   * @param sticker 贴纸编号，同时写入 pickBuffer
+   */
+  void fillSpan(CellBuffer &buffer, int y, int x0, int x1, int color,
+                char colorChar, uint8_t sticker);
+
+  /**
+   * @brief 在面板内容变化时重绘控制面板图层，并确定本帧面板位置
+   * @details 面板只依赖视图映射、缩放和动画状态，其余帧直接复用图层
+   * @param width 屏幕宽度
+   * @param height 屏幕高度
    */
-  void drawPolygon(WINDOW *win, const std::vector<std::pair<int, int>> &points,
-                   int colorPair, char colorChar);
+  void updateUIPanel(int width, int height);
+
+  /**
+   * @brief 按当前面板图层的尺寸确定本帧面板位置（不重绘图层）
+   * @param width 屏幕宽度
+   * @param height 屏幕高度
+   */
+  void placeUIPanel(int width, int height);
 
   /**
    * @brief 绘制用户界面（控制说明和状态信息）
-   * @param win ncurses窗口指针
-   * @param width 窗口宽度
-   * @param height 窗口高度
+   * @param buffer 目标缓冲区
+   * @param width 缓冲区宽度
+   * @param height 缓冲区高度
+   */
+  void drawUI(CellBuffer &buffer, int width, int height);
+
+  /**
+   * @brief 绘制分阶段耗时面板
+   * @param buffer 目标缓冲区
+   * @param right 面板右边界（不含）
+   * @param top 面板上边界
+   */
+  void drawStatsPanel(CellBuffer &buffer, int right, int top);
+
+  /**
+   * @brief 绘制画质档位和最近帧耗时的状态行（仅自动调整画质时）
+   * @param buffer 目标缓冲区
+   * @param x 起始列
+   * @param y 行
    */
-  void drawUI(WINDOW *win, int width, int height);
+  void drawGovernorStatus(CellBuffer &buffer, int x, int y);
 
 public:
   /**
@@ -170,18 +285,74 @@ public:
   void rotateViewDirection(const std::string &viewDirection, bool clockwise);
 
   /**
-   * @brief 更新动画状态
+   * @brief 以动画转动一个实际魔方面（结算进行中的动画）
+   * @param face 实际魔方面
+   * @param clockwise 是否顺时针旋转
    */
-  void updateAnimation();
+  void turnFace(Face face, bool clockwise);
 
   /**
-   * @brief 绘制魔方到终端窗口
-   * @param win ncurses窗口指针
-   * @param width 窗口宽度
-   * @param height 窗口高度
-   * @param colorCache 颜色缓存，避免重复初始化颜色对
+   * @brief 读取上一帧画在某个格子上的贴纸
+   * @details 光栅化时与颜色一起写入每个格子的贴纸编号，拾取只需查表，
+   *          不必重新投影所有贴纸
+   * @param x 列
+   * @param y 行
+   * @return 贴纸编号（块序号 * 6 + 面序号 + 1），没有贴纸或越界时为0
    */
-  void draw(WINDOW *win, int width, int height, std::map<int, int> &colorCache);
+  int stickerAt(int x, int y) const;
+
+  /**
+   * @brief 把在贴纸上的拖动换算为所在层的转动
+   * @details 贴纸所在平面内有两个坐标轴，分别计算贴纸绕它们转动时在屏幕
+   *          上的移动方向，取与拖动方向最接近的轴。该轴上贴纸所在的层是
+   *          中层时不转动（转动只有六个面）
+   * @param sticker stickerAt() 返回的贴纸编号
+   * @param dx 拖动的水平位移（列）
+   * @param dy 拖动的垂直位移（行）
+   * @param face 输出要转动的实际魔方面
+   * @param clockwise 输出是否顺时针
+   * @return 能换算为面的转动时返回true
+   */
+  bool resolveStickerDrag(int sticker, int dx, int dy, Face &face,
+                          bool &clockwise) const;
+
+  /**
+   * @brief 把转动序列加入动画队列，当前动画结束后依次播放
+   * @param moves 转动序列首地址
+   * @param count 转动个数
+   */
+  void queueMoves(const Move *moves, size_t count);
+
+  /**
+   * @brief 丢弃尚未开始播放的排队转动（进行中的动画照常完成）
+   */
+  void clearQueuedMoves() { moveQueue.clear(); }
+
+  /**
+   * @brief 是否没有进行中的动画和排队的转动
+   * @return 空闲时返回true
+   */
+  bool isIdle() const { return !animating && moveQueue.empty(); }
+
+  /**
+   * @brief 按经过的时间推进模拟
+   * @details 时间先累积起来，再以固定步长 1/TICK_RATE 秒逐步模拟；
+   *          不足一步的余量决定渲染时的插值系数。因此渲染掉帧不影响
+   *          转动的时长，无终端工具也可以用任意步长快于实时地推进
+   * @param elapsed 距上次调用经过的时间
+   */
+  void update(std::chrono::nanoseconds elapsed);
+
+  /**
+   * @brief 执行一个固定步长的模拟步
+   */
+  void step();
+
+  /**
+   * @brief 绘制魔方和界面到离屏缓冲区
+   * @param buffer 目标缓冲区（尺寸即画面尺寸）
+   */
+  void draw(CellBuffer &buffer);
 
   /**
    * @brief 重置魔方到初始状态（已解决状态）
@@ -193,6 +364,83 @@ public:
    * @param moves 打乱步数，默认为20
    */
   void scramble(int moves = 20);
+
+  /**
+   * @brief 批量执行转动序列（无动画）
+   * @details 先把整段序列组合成一个 PieceTransform，再对每个块更新一次姿态，
+   *          因此耗时与块数相关而几乎与序列长度无关
+   * @param moves 转动序列首地址
+   * @param count 转动个数
+   */
+  void applyMoves(const Move *moves, size_t count);
+
+  /**
+   * @brief 批量执行转动序列（无动画）
+   * @param moves 转动序列
+   */
+  void applyMoves(const std::vector<Move> &moves);
+
+  /**
+   * @brief 直接按块级状态摆放所有块（无动画，不经过转动序列）
+   * @details 每个角块、棱块的姿态是把它从初始位置移到目标位置、且参考面
+   *          贴纸落在对应朝向上的那个整90度旋转；进行中的动画和排队的转动
+   *          被丢弃，视角不变
+   * @param state 块级状态（须通过 CubeFormat::validate 校验）
+   */
+  void setState(const CubeState &state);
+
+  /**
+   * @brief 从块的姿态提取块级状态（进行中的动画视为已完成前的状态）
+   * @return 当前魔方状态
+   */
+  CubeState getState() const;
+
+  /**
+   * @brief 获取进行中的动画和排队的转动全部完成后的状态
+   * @return 魔方状态
+   */
+  CubeState getTargetState() const;
+
+  /**
+   * @brief 获取帧耗时统计（主循环用来记录 refresh 等阶段）
+   * @return 统计对象
+   */
+  FrameStats &getFrameStats() { return frameStats; }
+
+  /**
+   * @brief 获取帧耗时预算（主循环记录每帧耗时，绘制时按档位简化画面）
+   * @return 预算对象
+   */
+  FrameGovernor &getGovernor() { return governor; }
+
+  /**
+   * @brief 获取渲染临时数据的分配器（无终端回放用来报告其用量和增长）
+   * @return 分配器
+   */
+  const FrameArena &getFrameArena() const { return frameArena; }
+
+  /**
+   * @brief 切换耗时面板的显示
+   */
+  void toggleStats() { showStats = !showStats; }
+
+  /**
+   * @brief 设置打乱用的随机种子，使打乱结果可复现
+   * @param seed 种子
+   */
+  void setRandomSeed(uint32_t seed) { random.seed(seed); }
+
+  /**
+   * @brief 设置是否绘制界面（多魔方视图中每个格子只画魔方）
+   * @param show 是否绘制
+   */
+  void setShowUI(bool show) { showUI = show; }
+
+  /**
+   * @brief 直接设置缩放（不受 zoom() 的范围限制，用于较小的画面）
+   * @param value 缩放
+   */
+  void setScale(float value) { scale = value; }
 };
 
 #endif
@@ -41,12 +41,20 @@ public:
    */
   void rotate(const Vector3 &axis, float angle);
 
+  /**
+   * @brief 直接设置块的姿态（用于批量转动后一次性更新）
+   * @param position 块的当前位置
+   * @param rotation 块的局部旋转四元数
+   */
+  void setState(const Vector3 &position, const Quaternion &rotation);
+
   /**
    * @brief 获取指定面的角点坐标（局部坐标系）
    * @param faceName 面名称（"F", "B", "L", "R", "U", "D"）
-   * @return 面的四个角点坐标向量
+   * @param corners 输出的角点（至少能放4个）
+   * @return 角点个数，面名称无效时为0
    */
-  std::vector<Vector3> getFaceCorners(const std::string &faceName) const;
+  int getFaceCorners(const std::string &faceName, Vector3 *corners) const;
 
   /**
    * @brief 获取当前指定面的颜色
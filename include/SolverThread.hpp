@@ -0,0 +1,115 @@
+#ifndef SOLVER_THREAD_HPP
+#define SOLVER_THREAD_HPP
+
+#include "BidirectionalSolver.hpp"
+#include "CubeState.hpp"
+#include "Enums.hpp"
+#include "Move.hpp"
+#include "ThistlethwaiteSolver.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct SolveResult
+ * @brief 后台求解的结果
+ */
+struct SolveResult {
+  SolveKind kind;          ///< 请求的用途
+  std::vector<Move> moves; ///< 解（实际面的转动，已还原时为空）
+  double milliseconds;     ///< 求解耗时（毫秒）
+};
+
+/**
+ * @class SolverThread
+ * @brief 在后台线程上求解魔方，主循环每帧取回结果，不会被求解阻塞
+ * @details 请求携带提交时的状态快照，求解期间魔方可以继续绘制和动画。
+ *          cancel() 之后，正在进行的求解尽快中止，尚未取走的结果也被丢弃，
+ *          因此取回的结果总是对应最近一次提交、且之后没有被取消的请求
+ */
+class SolverThread {
+public:
+  /**
+   * @brief 构造函数，启动求解线程
+   * @param mode 求解方法；双向搜索达到内存或步数上限时改用 Thistlethwaite 法
+   * @param memoryLimit 双向搜索的内存上限（字节）
+   * @param maxDepth 双向搜索的步数上限，超过时改用 Thistlethwaite 法
+   */
+  explicit SolverThread(
+      SolverMode mode = SOLVER_THISTLETHWAITE,
+      size_t memoryLimit = BidirectionalSolver::DEFAULT_MEMORY_MB << 20,
+      int maxDepth = BidirectionalSolver::DEFAULT_MAX_DEPTH);
+
+  /**
+   * @brief 析构函数，取消未完成的请求并结束线程
+   */
+  ~SolverThread();
+
+  SolverThread(const SolverThread &) = delete;
+  SolverThread &operator=(const SolverThread &) = delete;
+
+  /**
+   * @brief 提交求解请求（先取消之前未完成的请求）
+   * @param state 魔方状态快照
+   * @param kind 请求的用途
+   */
+  void request(const CubeState &state, SolveKind kind);
+
+  /**
+   * @brief 取消正在进行和排队中的请求，丢弃尚未取走的结果
+   */
+  void cancel();
+
+  /**
+   * @brief 取出一个已完成的结果（不阻塞）
+   * @param result 输出的结果
+   * @return 有结果时返回true
+   */
+  bool poll(SolveResult &result);
+
+  /**
+   * @brief 等待所有已提交的请求完成（用于无终端回放，保证结果确定）
+   */
+  void waitIdle();
+
+  /**
+   * @brief 是否有尚未完成的请求
+   * @return 有时返回true
+   */
+  bool busy();
+
+private:
+  /**
+   * @struct Job
+   * @brief 排队中的请求
+   */
+  struct Job {
+    CubeState state;     ///< 状态快照
+    SolveKind kind;      ///< 请求的用途
+    uint64_t generation; ///< 提交时的代数，之后被取消则结果作废
+  };
+
+  /**
+   * @brief 求解线程主循环
+   */
+  void run();
+
+  SolverMode mode;                 ///< 求解方法
+  ThistlethwaiteSolver solver;     ///< 求解器（只在求解线程上使用）
+  BidirectionalSolver optimal;     ///< 最优求解器（只在求解线程上使用）
+  std::mutex mutex;                ///< 保护以下队列和状态
+  std::condition_variable wake;    ///< 有新请求或需要结束
+  std::condition_variable idle;    ///< 请求全部完成
+  std::deque<Job> jobs;            ///< 排队中的请求
+  std::deque<SolveResult> results; ///< 已完成、尚未取走的结果
+  uint64_t generation;             ///< 每次取消加一
+  bool working;                    ///< 求解线程正在求解
+  bool stopping;                   ///< 析构中
+  std::atomic<bool> cancelFlag;    ///< 通知求解器中止
+  std::thread thread;              ///< 求解线程（最后构造）
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef TABLE_BUILDER_HPP
+#define TABLE_BUILDER_HPP
+
+#include "PackedTable.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct BuildStats
+ * @brief 距离表生成的统计信息
+ */
+struct BuildStats {
+  std::vector<uint64_t> levelCounts; ///< 每个深度的状态数
+  double seconds;                    ///< 总耗时（秒）
+};
+
+/**
+ * @class TableBuilder
+ * @brief 多线程逐层广度优先搜索，把到起点的距离写入 PackedTable
+ * @details 每层按 64K 项的块分发给工作线程。前沿较小时正向扩展当前层的状态；
+ *          前沿超过未访问状态数时改为反向扫描：对每个未访问状态检查是否有
+ *          邻居在当前层。2位表存储 距离 mod 3（相邻状态距离差不超过1，
+ *          模3足以判断远近），4位表直接存储距离（最大14）
+ */
+class TableBuilder {
+public:
+  /**
+   * @brief 获取默认线程数
+   * @return 硬件并发数（至少为1）
+   */
+  static int defaultThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  /**
+   * @brief 生成距离表
+   * @tparam Neighbors 可调用对象 neighbors(index, visit)：对 index 的每个邻居
+   *         调用 visit(neighborIndex)，visit 返回true时可提前结束枚举
+   * @param table 要填写的表（所有项须为空）
+   * @param start 起点（距离0）的编号
+   * @param neighbors 邻居枚举函数，须可被多个线程同时调用
+   * @param threads 线程数，不大于0时使用 defaultThreads()
+   * @return 统计信息
+   */
+  template <typename Neighbors>
+  static BuildStats build(PackedTable &table, uint64_t start,
+                          const Neighbors &neighbors, int threads = 0) {
+    constexpr uint64_t BLOCK = 1 << 16;
+    const bool mod3 = table.bits() == 2;
+    const int empty = table.empty();
+    const uint64_t size = table.size();
+    const uint64_t blocks = (size + BLOCK - 1) / BLOCK;
+    if (threads <= 0) {
+      threads = defaultThreads();
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    BuildStats stats;
+    table.claim(start, 0);
+    stats.levelCounts.push_back(1);
+    uint64_t unvisited = size - 1;
+
+    for (int depth = 0; unvisited > 0; depth++) {
+      // 4位表最多表示到14，更深的状态保持为空
+      if (!mod3 && depth + 1 >= empty) {
+        break;
+      }
+
+      const int current = mod3 ? depth % 3 : depth;
+      const int next = mod3 ? (depth + 1) % 3 : depth + 1;
+      const bool forward = stats.levelCounts.back() < unvisited;
+      std::atomic<uint64_t> nextBlock(0);
+      std::atomic<uint64_t> found(0);
+
+      auto worker = [&]() {
+        uint64_t localFound = 0;
+        for (uint64_t block = nextBlock.fetch_add(1); block < blocks;
+             block = nextBlock.fetch_add(1)) {
+          uint64_t end = std::min(size, (block + 1) * BLOCK);
+          for (uint64_t index = block * BLOCK; index < end; index++) {
+            int value = table.get(index);
+            if (forward && value == current) {
+              neighbors(index, [&](uint64_t neighbor) {
+                if (table.claim(neighbor, next))
+                  localFound++;
+                return false;
+              });
+            } else if (!forward && value == empty) {
+              neighbors(index, [&](uint64_t neighbor) {
+                if (table.get(neighbor) != current)
+                  return false;
+                if (table.claim(index, next))
+                  localFound++;
+                return true;
+              });
+            }
+          }
+        }
+        found.fetch_add(localFound);
+      };
+
+      std::vector<std::thread> pool;
+      for (int i = 1; i < threads; i++) {
+        pool.emplace_back(worker);
+      }
+      worker();
+      for (auto &thread : pool) {
+        thread.join();
+      }
+
+      if (found == 0) {
+        break;
+      }
+      stats.levelCounts.push_back(found);
+      unvisited -= found;
+    }
+
+    stats.seconds = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - begin)
+                        .count();
+    return stats;
+  }
+};
+
+#endif
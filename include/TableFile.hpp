@@ -0,0 +1,96 @@
+#ifndef TABLE_FILE_HPP
+#define TABLE_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct TableFileHeader
+ * @brief 距离表文件头（64字节，数据紧随其后并保持8字节对齐）
+ */
+struct TableFileHeader {
+  char magic[8];         ///< 固定为 "RUBIKTBL"
+  uint32_t version;      ///< 文件格式版本
+  uint32_t bitsPerEntry; ///< 每项位数（2表示模3编码，4表示半字节）
+  uint64_t entryCount;   ///< 项数
+  uint64_t dataBytes;    ///< 数据字节数
+  uint64_t checksum;     ///< 数据校验和
+  char name[24];         ///< 表名（以 '\0' 结尾）
+};
+
+/**
+ * @class TableFile
+ * @brief 距离表文件的写入与只读映射
+ * @details 打开时直接 mmap 整个文件并校验文件头和校验和，
+ *          之后通过 words() 原地访问数据，不做任何解析或拷贝
+ *          （Windows 下退化为一次性读入内存）
+ */
+class TableFile {
+public:
+  static constexpr uint32_t VERSION = 1; ///< 当前文件格式版本
+
+  TableFile();
+  ~TableFile();
+  TableFile(const TableFile &) = delete;
+  TableFile &operator=(const TableFile &) = delete;
+
+  /**
+   * @brief 写入距离表文件
+   * @param path 文件路径
+   * @param name 表名（用于打开时校验）
+   * @param bitsPerEntry 每项位数
+   * @param entryCount 项数
+   * @param words 数据字数组
+   * @param wordCount 字数
+   * @return 写入成功返回true
+   */
+  static bool write(const std::string &path, const std::string &name,
+                    int bitsPerEntry, uint64_t entryCount,
+                    const uint64_t *words, size_t wordCount);
+
+  /**
+   * @brief 映射距离表文件并校验
+   * @param path 文件路径
+   * @param name 期望的表名
+   * @param bitsPerEntry 期望的每项位数
+   * @param entryCount 期望的项数
+   * @return 文件存在且版本、表名、尺寸、校验和都匹配时返回true
+   */
+  bool open(const std::string &path, const std::string &name, int bitsPerEntry,
+            uint64_t entryCount);
+
+  /**
+   * @brief 解除映射
+   */
+  void close();
+
+  /**
+   * @brief 获取数据字数组
+   * @return 首地址，未打开时为nullptr
+   */
+  const uint64_t *words() const { return data; }
+
+  /**
+   * @brief 获取文件总字节数（含文件头）
+   * @return 字节数
+   */
+  size_t fileSize() const { return mappedSize; }
+
+  /**
+   * @brief 计算数据校验和（按64位字的 FNV-1a）
+   * @param words 数据字数组
+   * @param wordCount 字数
+   * @return 校验和
+   */
+  static uint64_t checksum(const uint64_t *words, size_t wordCount);
+
+private:
+  const uint64_t *data;             ///< 数据区首地址
+  void *mapping;                    ///< 映射区首地址
+  size_t mappedSize;                ///< 映射区大小
+  std::vector<uint64_t> fallback;   ///< 不支持 mmap 时的内存副本
+};
+
+#endif
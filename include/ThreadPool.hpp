@@ -0,0 +1,73 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief 固定数量工作线程的并行循环
+ * @details 线程在构造时创建、析构时结束，每次 run() 只唤醒它们，不再
+ *          创建线程。调用 run() 的线程也参与执行，任务编号用原子计数器
+ *          动态领取，耗时不均的任务也能分摊
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief 构造函数
+   * @param threads 参与执行的线程总数（含调用 run() 的线程），
+   *        不大于0时使用硬件并发数
+   */
+  explicit ThreadPool(int threads = 0);
+
+  /**
+   * @brief 析构函数，结束所有工作线程
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief 并行执行 task(0) ... task(count - 1)，全部完成后返回
+   * @param count 任务个数
+   * @param task 任务函数，须可被多个线程同时调用
+   */
+  void run(size_t count, const std::function<void(size_t)> &task);
+
+  /**
+   * @brief 参与执行的线程总数
+   * @return 线程数
+   */
+  int size() const { return static_cast<int>(workers.size()) + 1; }
+
+private:
+  /**
+   * @brief 领取并执行任务，直到本轮任务领完
+   */
+  void work();
+
+  /**
+   * @brief 工作线程主循环
+   */
+  void workerLoop();
+
+  std::vector<std::thread> workers;           ///< 工作线程
+  std::mutex mutex;                           ///< 保护下面的状态
+  std::condition_variable wake;               ///< 通知工作线程开始新一轮
+  std::condition_variable done;               ///< 通知 run() 本轮结束
+  const std::function<void(size_t)> *current; ///< 本轮的任务函数
+  size_t taskCount;                           ///< 本轮的任务个数
+  std::atomic<size_t> nextTask;               ///< 下一个待领取的任务
+  uint64_t generation;                        ///< 轮次编号
+  int busy;                                   ///< 本轮尚未结束的工作线程
+  bool stopping;                              ///< 析构中
+};
+
+#endif
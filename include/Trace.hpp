@@ -0,0 +1,93 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct TraceEvent
+ * @brief 一个开始或结束事件
+ */
+struct TraceEvent {
+  const char *name; ///< 事件名（须为字符串常量）
+  uint64_t nanos;   ///< 距离首次记录的纳秒数
+  char phase;       ///< 'B' 开始，'E' 结束
+};
+
+/**
+ * @class Trace
+ * @brief 低开销的时间线追踪，输出 Chrome/Perfetto 的 trace event JSON
+ * @details 每个线程第一次记录时分配自己的环形缓冲区，记录时只写本线程的
+ *          缓冲区，不加锁；缓冲区写满后覆盖最旧的事件。只有定义了
+ *          RUBIK_TRACE（CMake 选项 -DRUBIK_TRACE=ON）时 TRACE_* 宏才会
+ *          展开，否则插桩代码完全不参与编译
+ */
+class Trace {
+public:
+  static constexpr uint32_t RING_SIZE = 1 << 17; ///< 每线程事件数（2的幂）
+
+  /**
+   * @brief 记录开始事件
+   * @param name 事件名
+   */
+  static void begin(const char *name) { record(name, 'B'); }
+
+  /**
+   * @brief 记录结束事件
+   * @param name 事件名
+   */
+  static void end(const char *name) { record(name, 'E'); }
+
+  /**
+   * @brief 设置当前线程在时间线上显示的名称
+   * @param name 线程名
+   */
+  static void setThreadName(const char *name);
+
+  /**
+   * @brief 把所有线程的事件写成 Chrome trace JSON
+   * @param path 文件路径
+   * @return 写入成功返回true
+   * @note 调用时其他线程不应再记录事件（通常在退出、线程已 join 之后）
+   */
+  static bool write(const std::string &path);
+
+private:
+  static void record(const char *name, char phase);
+};
+
+/**
+ * @class TraceScope
+ * @brief 作用域追踪：构造时记录开始事件，析构时记录结束事件
+ */
+class TraceScope {
+public:
+  explicit TraceScope(const char *name) : name(name) { Trace::begin(name); }
+  ~TraceScope() { Trace::end(name); }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  const char *name; ///< 事件名
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef RUBIK_TRACE
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_BEGIN(name) Trace::begin(name)
+#define TRACE_END(name) Trace::end(name)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#define TRACE_WRITE(path) Trace::write(path)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_WRITE(path) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+#include "CubeState.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @enum BoundType
+ * @brief 置换表中距离值的性质
+ */
+enum BoundType : uint8_t {
+  BOUND_NONE = 0,  ///< 空条目
+  BOUND_EXACT = 1, ///< 精确距离
+  BOUND_LOWER = 2, ///< 距离下界（搜索失败得到）
+  BOUND_UPPER = 3  ///< 距离上界（已找到解）
+};
+
+/**
+ * @struct TableEntry
+ * @brief 置换表中保存的搜索信息
+ */
+struct TableEntry {
+  uint8_t depth;   ///< 产生该结果的剩余搜索深度
+  uint8_t value;   ///< 到还原状态的距离值
+  BoundType bound; ///< 距离值的性质
+};
+
+/**
+ * @class TranspositionTable
+ * @brief 以 StateCode 为键的定长无锁置换表，可被多个搜索线程共享
+ * @details 每个槽位由两个64位原子字组成：data 保存角块坐标和条目内容，
+ *          check 保存 棱块坐标 ^ data。读者校验两者异或是否还原出完整键，
+ *          因此并发写入造成的撕裂读会被当作未命中，无需任何锁。
+ *          每个桶有两个槽位：一个按深度优先保留，一个总是替换
+ */
+class TranspositionTable {
+public:
+  /**
+   * @brief 构造函数，分配置换表
+   * @param capacity 槽位个数（向下取整到2的幂，至少为2）
+   */
+  explicit TranspositionTable(size_t capacity);
+
+  /**
+   * @brief 查询状态
+   * @param code 状态编码
+   * @param entry 命中时输出条目
+   * @return 命中返回true
+   */
+  bool probe(const StateCode &code, TableEntry &entry) const;
+
+  /**
+   * @brief 写入状态（可能覆盖其他状态的条目）
+   * @param code 状态编码
+   * @param entry 要写入的条目
+   */
+  void store(const StateCode &code, const TableEntry &entry);
+
+  /**
+   * @brief 清空所有条目（调用时不应有其他线程在访问）
+   */
+  void clear();
+
+  /**
+   * @brief 获取槽位个数
+   * @return 槽位个数
+   */
+  size_t capacity() const { return bucketMask * 2 + 2; }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> check; ///< 棱块坐标 ^ data
+    std::atomic<uint64_t> data;  ///< 角块坐标与条目内容
+  };
+
+  std::unique_ptr<Slot[]> slots; ///< 槽位数组（每两个为一个桶）
+  size_t bucketMask;             ///< 桶编号掩码
+
+  static uint64_t pack(const StateCode &code, const TableEntry &entry);
+  static bool matches(const StateCode &code, uint64_t check, uint64_t data);
+  static TableEntry unpack(uint64_t data);
+};
+
+#endif
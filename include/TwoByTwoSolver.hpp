@@ -0,0 +1,93 @@
+#ifndef TWO_BY_TWO_SOLVER_HPP
+#define TWO_BY_TWO_SOLVER_HPP
+
+#include "CubeState.hpp"
+#include "Move.hpp"
+#include "PackedTable.hpp"
+#include "TableBuilder.hpp"
+#include "TableFile.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class TwoByTwoSolver
+ * @brief 2x2x2 魔方的完整距离表与最优求解器
+ * @details 固定 DBL 角块后，2x2 状态为 7!·3^6 = 3674160 个，只用 U、R、F
+ *          三个面的9种转动（半圈计一步）。距离表每个状态占2位，存储
+ *          距离 mod 3：相邻状态距离相差不超过1，因此从任意状态出发，
+ *          每次选一个取值为 (v-1) mod 3 的邻居即可贪心下降到还原状态，
+ *          得到的就是最优解
+ */
+class TwoByTwoSolver {
+public:
+  static constexpr uint32_t STATE_COUNT = 3674160; ///< 状态总数
+  static constexpr int MOVE_COUNT = 9;             ///< 可用转动数
+
+  /**
+   * @brief 构造函数（不生成距离表）
+   */
+  TwoByTwoSolver();
+
+  /**
+   * @brief 用多线程广度优先搜索生成距离表
+   * @param threads 线程数，不大于0时使用全部硬件线程
+   * @return 统计信息（每层状态数和耗时）
+   */
+  BuildStats generate(int threads = 0);
+
+  /**
+   * @brief 将距离表保存到文件
+   * @param path 文件路径
+   * @return 保存成功返回true
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * @brief 通过 mmap 加载距离表
+   * @param path 文件路径
+   * @return 加载并校验成功返回true
+   */
+  bool load(const std::string &path);
+
+  /**
+   * @brief 判断距离表是否可用
+   * @return 已生成或已加载返回true
+   */
+  bool isReady() const { return words != nullptr; }
+
+  /**
+   * @brief 计算最优解（只看角块，即把状态当作 2x2 魔方）
+   * @param state 魔方状态（通常来自 RubiksCube::getState()）
+   * @return 以原状态朝向表示的最优转动序列；距离表不可用时为空
+   * @note 执行解后角块整体还原，但可能相对中心块整体转过一个角度
+   */
+  std::vector<Move> solve(const CubeState &state) const;
+
+  /**
+   * @brief 计算到还原状态的最优步数
+   * @param state 魔方状态
+   * @return 最优步数；距离表不可用时返回-1
+   */
+  int distance(const CubeState &state) const;
+
+  /**
+   * @brief 计算固定 DBL 后的状态编号
+   * @param state DBL 位置上为 DBL 角块且朝向为0的状态
+   * @return 状态编号（0 为还原状态）
+   */
+  static uint32_t indexOf(const CubeState &state);
+
+private:
+  std::unique_ptr<PackedTable> generated; ///< 生成的距离表
+  TableFile mapped;                       ///< 映射的距离表文件
+  const uint64_t *words;                  ///< 当前使用的距离表数据
+
+  int valueAt(uint32_t index) const {
+    return static_cast<int>((words[index / 32] >> (index % 32 * 2)) & 3);
+  }
+
+  std::vector<Move> descend(uint32_t index, int rotation) const;
+};
+
+#endif
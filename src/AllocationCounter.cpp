@@ -0,0 +1,25 @@
+#include "AllocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local uint64_t allocationCount = 0;
+
+} // namespace
+
+uint64_t AllocationCounter::count() { return allocationCount; }
+
+void *operator new(std::size_t size) {
+  allocationCount++;
+  if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
@@ -0,0 +1,88 @@
+#include "AnsiEncoder.hpp"
+
+AnsiEncoder::AnsiEncoder() : fullRedraw(true) {}
+
+void AnsiEncoder::appendNumber(int value) {
+  char digits[12];
+  int length = 0;
+  do {
+    digits[length++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  while (length > 0) {
+    out += digits[--length];
+  }
+}
+
+const std::string &AnsiEncoder::encode(const CellBuffer &buffer) {
+  int width = buffer.width();
+  int height = buffer.height();
+  out.clear();
+
+  if (fullRedraw || previous.width() != width ||
+      previous.height() != height) {
+    // 清屏后上一帧视为全空，下面逐格比较时会输出所有非空格子
+    previous.resize(width, height);
+    out += "\x1b[0m\x1b[2J";
+    fullRedraw = false;
+  }
+
+  int cursorX = -1;
+  int cursorY = -1;
+  int currentColor = -1;
+  uint8_t currentAttr = CellBuffer::ATTR_NONE;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      const Cell &cell = buffer.at(x, y);
+      if (cell == previous.at(x, y)) {
+        continue;
+      }
+      previous.set(x, y, cell.ch, cell.color, cell.attr);
+
+      if (y == cursorY && x > cursorX && x - cursorX <= MAX_SKIP) {
+        // 中间没变的格子很少且属性相同时直接重写，比移动光标更短
+        int gap = cursorX;
+        while (gap < x && buffer.at(gap, y).color == currentColor &&
+               buffer.at(gap, y).attr == currentAttr) {
+          gap++;
+        }
+        if (gap == x) {
+          for (int i = cursorX; i < x; i++) {
+            out += buffer.at(i, y).ch;
+          }
+          cursorX = x;
+        }
+      }
+      if (x != cursorX || y != cursorY) {
+        out += "\x1b[";
+        appendNumber(y + 1);
+        out += ';';
+        appendNumber(x + 1);
+        out += 'H';
+      }
+      if (cell.color != currentColor || cell.attr != currentAttr) {
+        // 与 ncurses 后端一致：有颜色的格子使用黑色背景
+        out += "\x1b[0";
+        if (cell.attr & CellBuffer::ATTR_REVERSE) {
+          out += ";7";
+        }
+        if (cell.color >= 0) {
+          out += ";38;5;";
+          appendNumber(cell.color);
+          out += ";40";
+        }
+        out += 'm';
+        currentColor = cell.color;
+        currentAttr = cell.attr;
+      }
+      out += cell.ch;
+      cursorX = x + 1;
+      cursorY = y;
+    }
+  }
+
+  if (currentColor != -1 || currentAttr != CellBuffer::ATTR_NONE) {
+    out += "\x1b[0m";
+  }
+  return out;
+}
@@ -0,0 +1,39 @@
+#include "AnsiRenderer.hpp"
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+AnsiRenderer::AnsiRenderer(int fd) : fd(fd), totalBytes(0) {}
+
+void AnsiRenderer::present(const CellBuffer &buffer) {
+  const std::string &out = encoder.encode(buffer);
+  size_t offset = 0;
+  while (offset < out.size()) {
+    auto written = write(fd, out.data() + offset,
+                         static_cast<unsigned>(out.size() - offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+#ifndef _WIN32
+      // fd 是非阻塞的且终端暂时收不下：等到可写再继续，不空转重试
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        pollfd ready = {fd, POLLOUT, 0};
+        if (poll(&ready, 1, -1) >= 0 || errno == EINTR) {
+          continue;
+        }
+      }
+#endif
+      // 没写完的部分终端上不一定是什么内容，下一帧完整重绘
+      encoder.invalidate();
+      break;
+    }
+    offset += static_cast<size_t>(written);
+  }
+  totalBytes += offset;
+}
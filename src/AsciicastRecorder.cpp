@@ -0,0 +1,167 @@
+#include "AsciicastRecorder.hpp"
+#include "Trace.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+AsciicastRecorder::AsciicastRecorder()
+    : file(nullptr), stopping(false), droppedFrames(0), startTime(0),
+      width(0), height(0), writtenFrames(0), writtenBytes(0), failed(false) {}
+
+AsciicastRecorder::~AsciicastRecorder() { close(); }
+
+bool AsciicastRecorder::open(const std::string &path) {
+  if (file) {
+    return false;
+  }
+  file = std::fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+  std::setvbuf(file, nullptr, _IOFBF, 64 * 1024);
+  startTime = std::time(nullptr);
+  stopping = false;
+  thread = std::thread(&AsciicastRecorder::run, this);
+  return true;
+}
+
+void AsciicastRecorder::record(CellBuffer &frame, double seconds) {
+  if (!file) {
+    return;
+  }
+
+  Slot slot;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.size() >= QUEUE_FRAMES) {
+      droppedFrames++;
+      return;
+    }
+    if (!spare.empty()) {
+      slot = std::move(spare.back());
+      spare.pop_back();
+    }
+  }
+  // 交换而不复制；换回的是已写出的旧帧，尺寸不变时不分配内存
+  slot.frame.swap(frame);
+  if (frame.width() != slot.frame.width() ||
+      frame.height() != slot.frame.height()) {
+    frame.resize(slot.frame.width(), slot.frame.height());
+  }
+  slot.seconds = seconds;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  queue.push_back(std::move(slot));
+  wake.notify_one();
+}
+
+void AsciicastRecorder::waitForSpace() {
+  if (!file) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  space.wait(lock, [this]() { return queue.size() < QUEUE_FRAMES; });
+}
+
+bool AsciicastRecorder::close() {
+  if (!file) {
+    return true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  thread.join();
+
+  bool ok = !failed;
+  ok = std::fclose(file) == 0 && ok;
+  file = nullptr;
+  return ok;
+}
+
+void AsciicastRecorder::run() {
+  TRACE_THREAD_NAME("recorder");
+#ifdef __linux__
+  // 最低优先级：只在其他线程空闲（主线程睡眠或等待队列）时运行，单核上
+  // 也不会在一帧中间抢占主线程
+  sched_param param = {};
+  pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+    if (queue.empty()) {
+      return; // 关闭时先写完排队的帧
+    }
+    Slot slot = std::move(queue.front());
+    queue.pop_front();
+    space.notify_one();
+    lock.unlock();
+
+    writeFrame(slot);
+
+    lock.lock();
+    spare.push_back(std::move(slot));
+  }
+}
+
+void AsciicastRecorder::writeFrame(const Slot &slot) {
+  TRACE_SCOPE("record");
+  const CellBuffer &frame = slot.frame;
+  if (width == 0) {
+    int length = std::fprintf(
+        file,
+        "{\"version\": 2, \"width\": %d, \"height\": %d, \"timestamp\": %lld, "
+        "\"env\": {\"TERM\": \"xterm-256color\"}}\n",
+        frame.width(), frame.height(), static_cast<long long>(startTime));
+    failed = failed || length < 0;
+    writtenBytes += length > 0 ? static_cast<uint64_t>(length) : 0;
+    writeEvent(slot.seconds, "o", "\x1b[?25l");
+  } else if (frame.width() != width || frame.height() != height) {
+    writeEvent(slot.seconds, "r",
+               std::to_string(frame.width()) + "x" +
+                   std::to_string(frame.height()));
+  }
+  width = frame.width();
+  height = frame.height();
+
+  // 画面没有变化的帧不产生事件
+  const std::string &output = encoder.encode(frame);
+  if (!output.empty()) {
+    writeEvent(slot.seconds, "o", output);
+  }
+  writtenFrames++;
+}
+
+void AsciicastRecorder::writeEvent(double seconds, const char *type,
+                                   const std::string &data) {
+  static const char HEX[] = "0123456789abcdef";
+  char prefix[64];
+  int length = std::snprintf(prefix, sizeof(prefix), "[%.6f, \"%s\", \"",
+                             seconds, type);
+  line.assign(prefix, static_cast<size_t>(length));
+
+  // 转义序列里的 ESC 等控制字符按 JSON 规则写成 \u00XX；输出只含 ASCII
+  for (char c : data) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    if (c == '"' || c == '\\') {
+      line += '\\';
+      line += c;
+    } else if (byte < 0x20 || byte >= 0x7f) {
+      line += "\\u00";
+      line += HEX[byte >> 4];
+      line += HEX[byte & 0xf];
+    } else {
+      line += c;
+    }
+  }
+  line += "\"]\n";
+
+  if (std::fwrite(line.data(), 1, line.size(), file) != line.size()) {
+    failed = true;
+  }
+  writtenBytes += line.size();
+}
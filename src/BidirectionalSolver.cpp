@@ -0,0 +1,183 @@
+#include "BidirectionalSolver.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// 每展开这么多个状态检查一次取消标志
+constexpr size_t CANCEL_INTERVAL = 4096;
+
+// 从已排序、去重的 next 中去掉同样已排序的 seen 里出现过的编码
+void removeSeen(std::vector<StateCode> &next,
+                const std::vector<StateCode> &seen) {
+  size_t kept = 0;
+  auto other = seen.begin();
+  for (const StateCode &code : next) {
+    while (other != seen.end() && *other < code) {
+      ++other;
+    }
+    if (other == seen.end() || code < *other) {
+      next[kept++] = code;
+    }
+  }
+  next.resize(kept);
+}
+
+// 在两个已排序的数组中找一个公共编码
+bool findCommon(const std::vector<StateCode> &a,
+                const std::vector<StateCode> &b, StateCode &common) {
+  auto i = a.begin();
+  auto j = b.begin();
+  while (i != a.end() && j != b.end()) {
+    if (*i < *j) {
+      ++i;
+    } else if (*j < *i) {
+      ++j;
+    } else {
+      common = *i;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+BidirectionalSolver::BidirectionalSolver(size_t memoryLimit, int maxDepth)
+    : limit(memoryLimit), depthLimit(maxDepth) {}
+
+void BidirectionalSolver::clearCache() {
+  goalLevels.clear();
+  goalLevels.shrink_to_fit();
+}
+
+size_t BidirectionalSolver::usedBytes() const {
+  size_t bytes = 0;
+  for (const std::vector<Level> *side : {&goalLevels, &startLevels}) {
+    for (const Level &level : *side) {
+      bytes += level.capacity() * sizeof(StateCode);
+    }
+  }
+  return bytes;
+}
+
+bool BidirectionalSolver::solve(const CubeState &state,
+                                std::vector<Move> &solution,
+                                const std::atomic<bool> *cancel) {
+  solution.clear();
+  stats = BidirectionalStats();
+  if (goalLevels.empty()) {
+    goalLevels.push_back(Level{CubeState().encode()});
+  }
+  stats.cachedDepth = static_cast<int>(goalLevels.size()) - 1;
+
+  // 所求状态已在缓存的某一层中时直接沿还原一侧走回
+  StateCode start = state.encode();
+  for (size_t depth = 0; depth < goalLevels.size(); depth++) {
+    if (std::binary_search(goalLevels[depth].begin(), goalLevels[depth].end(),
+                           start)) {
+      walkBack(goalLevels, state, static_cast<int>(depth), solution);
+      stats.peakBytes = usedBytes();
+      return true;
+    }
+  }
+
+  // 此后始终有：最优步数 > 两侧深度之和。展开一侧后只需把新一层与另一侧
+  // 最深的一层求交，第一次相交即得到最优解
+  startLevels.assign(1, Level{start});
+  bool found = false;
+  StateCode middle = {0, 0};
+  while (!found) {
+    if (goalLevels.size() + startLevels.size() - 2 >=
+        static_cast<size_t>(depthLimit)) {
+      stats.depthReached = true;
+      break;
+    }
+    // 两侧一样大时展开还原一侧：它会缓存下来，以后的求解不必再展开
+    bool backward = goalLevels.back().size() <= startLevels.back().size();
+    std::vector<Level> &levels = backward ? goalLevels : startLevels;
+    size_t needed = levels.back().size() * Move::COUNT * sizeof(StateCode);
+    if (levels.back().empty() || usedBytes() + needed > limit) {
+      stats.limitReached = true;
+      break;
+    }
+    if (!expand(levels, backward, cancel)) {
+      break;
+    }
+    stats.peakBytes = std::max(stats.peakBytes, usedBytes());
+    found = findCommon(goalLevels.back(), startLevels.back(), middle);
+  }
+
+  if (found) {
+    // 起始一侧走回的转动取逆、倒序，即从所求状态走到相遇状态的路径
+    CubeState meeting = CubeState::decode(middle);
+    std::vector<Move> path;
+    walkBack(startLevels, meeting, static_cast<int>(startLevels.size()) - 1,
+             path);
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+      solution.push_back(it->inverse());
+    }
+    walkBack(goalLevels, meeting, static_cast<int>(goalLevels.size()) - 1,
+             solution);
+  }
+  startLevels.clear();
+  return found;
+}
+
+bool BidirectionalSolver::expand(std::vector<Level> &levels, bool backward,
+                                 const std::atomic<bool> *cancel) {
+  auto begin = std::chrono::steady_clock::now();
+  const Level &frontier = levels.back();
+  Level next;
+  next.reserve(frontier.size() * Move::COUNT);
+  for (size_t i = 0; i < frontier.size(); i++) {
+    if (cancel && i % CANCEL_INTERVAL == 0 && cancel->load()) {
+      return false;
+    }
+    CubeState state = CubeState::decode(frontier[i]);
+    for (int index = 0; index < Move::COUNT; index++) {
+      next.push_back(CubeState::multiply(
+                         state, CubeState::moveState(Move::fromIndex(index)))
+                         .encode());
+    }
+  }
+  size_t generated = next.size();
+
+  // 转动集合对取逆封闭，邻居只可能在上一层、本层或下一层：去重后去掉
+  // 本侧最深两层中已有的状态，剩下的恰好是下一层
+  std::sort(next.begin(), next.end());
+  next.erase(std::unique(next.begin(), next.end()), next.end());
+  removeSeen(next, frontier);
+  if (levels.size() >= 2) {
+    removeSeen(next, levels[levels.size() - 2]);
+  }
+  // 去重后通常远小于预留的容量，按实际大小重新分配，usedBytes 才准确
+  next.shrink_to_fit();
+  levels.push_back(std::move(next));
+
+  stats.levels.push_back(FrontierLevel{
+      backward, static_cast<int>(levels.size()) - 1, generated,
+      levels.back().size(),
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - begin)
+          .count()});
+  return true;
+}
+
+void BidirectionalSolver::walkBack(const std::vector<Level> &levels,
+                                   CubeState state, int depth,
+                                   std::vector<Move> &path) {
+  for (int d = depth; d > 0; d--) {
+    const Level &previous = levels[d - 1];
+    for (int index = 0; index < Move::COUNT; index++) {
+      Move move = Move::fromIndex(index);
+      CubeState next = CubeState::multiply(state, CubeState::moveState(move));
+      if (std::binary_search(previous.begin(), previous.end(),
+                             next.encode())) {
+        path.push_back(move);
+        state = next;
+        break;
+      }
+    }
+  }
+}
@@ -0,0 +1,70 @@
+#include "CellBuffer.hpp"
+#include <algorithm>
+
+static const Cell BLANK = {' ', -1, CellBuffer::ATTR_NONE};
+
+CellBuffer::CellBuffer(int width, int height)
+    : bufferWidth(0), bufferHeight(0) {
+  resize(width, height);
+}
+
+void CellBuffer::resize(int width, int height) {
+  bufferWidth = std::max(0, width);
+  bufferHeight = std::max(0, height);
+  cells.assign(static_cast<size_t>(bufferWidth) * bufferHeight, BLANK);
+}
+
+void CellBuffer::clear() { std::fill(cells.begin(), cells.end(), BLANK); }
+
+void CellBuffer::text(int x, int y, const char *text, uint8_t attr) {
+  for (int i = 0; text[i] != '\0'; i++) {
+    set(x + i, y, text[i], -1, attr);
+  }
+}
+
+void CellBuffer::fill(int y, int x0, int x1, char ch, int color,
+                      uint8_t attr) {
+  if (y < 0 || y >= bufferHeight) {
+    return;
+  }
+  x0 = std::max(0, x0);
+  x1 = std::min(bufferWidth - 1, x1);
+  if (x0 > x1) {
+    return;
+  }
+  auto row = cells.begin() + static_cast<size_t>(y) * bufferWidth;
+  std::fill(row + x0, row + x1 + 1,
+            Cell{ch, static_cast<int16_t>(color), attr});
+}
+
+void CellBuffer::blit(const CellBuffer &source, int x, int y) {
+  int left = std::max(0, -x);
+  int right = std::min(source.bufferWidth, bufferWidth - x);
+  if (left >= right) {
+    return;
+  }
+  for (int row = std::max(0, -y);
+       row < source.bufferHeight && row + y < bufferHeight; row++) {
+    auto from = source.cells.begin() +
+                static_cast<size_t>(row) * source.bufferWidth;
+    std::copy(from + left, from + right,
+              cells.begin() + static_cast<size_t>(row + y) * bufferWidth + x +
+                  left);
+  }
+}
+
+uint64_t CellBuffer::hash() const {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  auto mix = [&hash](uint8_t byte) {
+    hash ^= byte;
+    hash *= 0x100000001B3ULL;
+  };
+  mix(static_cast<uint8_t>(bufferWidth));
+  mix(static_cast<uint8_t>(bufferHeight));
+  for (const Cell &cell : cells) {
+    mix(static_cast<uint8_t>(cell.ch));
+    mix(static_cast<uint8_t>(cell.color));
+    mix(cell.attr);
+  }
+  return hash;
+}
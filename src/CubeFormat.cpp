@@ -0,0 +1,303 @@
+#include "CubeFormat.hpp"
+#include <bitset>
+#include <cstring>
+
+namespace {
+
+const char LETTERS[] = "URFDLB"; // 颜色 0-5 对应的字母
+constexpr uint8_t NONE = 0xff;
+
+// 块记号中各位置的贴纸序号，按位置名称中各面的顺序
+const uint8_t CUBIE_EDGES[12][2] = {
+    {7, 19},  {5, 10},  {1, 46},  {3, 37},  {28, 25}, {32, 16},
+    {34, 52}, {30, 43}, {23, 12}, {21, 41}, {48, 14}, {50, 39}};
+const uint8_t CUBIE_CORNERS[8][3] = {
+    {8, 20, 9},   {2, 11, 45},  {0, 47, 36},  {6, 38, 18},
+    {29, 15, 26}, {27, 24, 44}, {33, 42, 53}, {35, 51, 17}};
+
+/**
+ * @struct FormatTables
+ * @brief 字母与颜色、颜色组合与块之间的查找表
+ */
+struct FormatTables {
+  uint8_t color[256];     ///< 字母 → 颜色（非法字母为 NONE）
+  uint8_t corner[6 * 36]; ///< 按位置顺序读出的三色 → 角块编号 × 3 + 朝向
+  uint8_t edge[36];       ///< 按位置顺序读出的两色 → 棱块编号 × 2 + 翻转
+
+  FormatTables() {
+    std::memset(color, NONE, sizeof(color));
+    std::memset(corner, NONE, sizeof(corner));
+    std::memset(edge, NONE, sizeof(edge));
+    for (int c = 0; c < 6; c++) {
+      color[static_cast<uint8_t>(LETTERS[c])] = static_cast<uint8_t>(c);
+    }
+    // 朝向为 t 时，位置上第 k 个贴纸是角块的第 (k - t) mod 3 个贴纸
+    for (int i = 0; i < 8; i++) {
+      const uint8_t *facelets = FaceletCube::CORNER_FACELETS[i];
+      for (int t = 0; t < 3; t++) {
+        int key = 0;
+        for (int k = 0; k < 3; k++) {
+          key = key * 6 + facelets[(k - t + 3) % 3] / 9;
+        }
+        corner[key] = static_cast<uint8_t>(i * 3 + t);
+      }
+    }
+    for (int i = 0; i < 12; i++) {
+      int a = FaceletCube::EDGE_FACELETS[i][0] / 9;
+      int b = FaceletCube::EDGE_FACELETS[i][1] / 9;
+      edge[a * 6 + b] = static_cast<uint8_t>(i * 2);
+      edge[b * 6 + a] = static_cast<uint8_t>(i * 2 + 1);
+    }
+  }
+};
+
+const FormatTables &formatTables() {
+  static const FormatTables instance;
+  return instance;
+}
+
+// 逆序数的奇偶性：位掩码记下已出现的元素，比当前元素大的个数即其中
+// 高于当前元素的位数（要求 perm 是排列）
+int parity(const uint8_t *perm, int n) {
+  unsigned seen = 0;
+  size_t inversions = 0;
+  for (int i = 0; i < n; i++) {
+    inversions += std::bitset<16>(seen >> perm[i]).count();
+    seen |= 1u << perm[i];
+  }
+  return static_cast<int>(inversions & 1);
+}
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+} // namespace
+
+StateError CubeFormat::validate(const CubeState &state) {
+  unsigned corners = 0, edges = 0;
+  int twist = 0, flip = 0;
+  for (int i = 0; i < 8; i++) {
+    if (state.cp[i] >= 8 || state.co[i] >= 3) {
+      return STATE_BAD_CORNER;
+    }
+    corners |= 1u << state.cp[i];
+    twist += state.co[i];
+  }
+  for (int i = 0; i < 12; i++) {
+    if (state.ep[i] >= 12 || state.eo[i] >= 2) {
+      return STATE_BAD_EDGE;
+    }
+    edges |= 1u << state.ep[i];
+    flip += state.eo[i];
+  }
+
+  if (corners != 0xffu) {
+    return STATE_DUPLICATE_CORNER;
+  }
+  if (edges != 0xfffu) {
+    return STATE_DUPLICATE_EDGE;
+  }
+  if (twist % 3 != 0) {
+    return STATE_TWIST;
+  }
+  if (flip % 2 != 0) {
+    return STATE_FLIP;
+  }
+  if (parity(state.cp, 8) != parity(state.ep, 12)) {
+    return STATE_PARITY;
+  }
+  return STATE_OK;
+}
+
+StateError CubeFormat::fromFacelets(const FaceletCube &cube,
+                                    CubeState &state) {
+  const FormatTables &tables = formatTables();
+  const uint8_t *facelets = cube.facelets;
+  for (int f = 0; f < 6; f++) {
+    if (facelets[f * 9 + 4] != f) {
+      return STATE_BAD_CENTER;
+    }
+  }
+
+  for (int j = 0; j < 8; j++) {
+    const uint8_t *position = FaceletCube::CORNER_FACELETS[j];
+    uint8_t a = facelets[position[0]];
+    uint8_t b = facelets[position[1]];
+    uint8_t c = facelets[position[2]];
+    uint8_t corner =
+        a < 6 && b < 6 && c < 6 ? tables.corner[a * 36 + b * 6 + c] : NONE;
+    if (corner == NONE) {
+      return STATE_BAD_CORNER;
+    }
+    state.cp[j] = static_cast<uint8_t>(corner / 3);
+    state.co[j] = static_cast<uint8_t>(corner % 3);
+  }
+
+  for (int j = 0; j < 12; j++) {
+    const uint8_t *position = FaceletCube::EDGE_FACELETS[j];
+    uint8_t a = facelets[position[0]];
+    uint8_t b = facelets[position[1]];
+    uint8_t edge = a < 6 && b < 6 ? tables.edge[a * 6 + b] : NONE;
+    if (edge == NONE) {
+      return STATE_BAD_EDGE;
+    }
+    state.ep[j] = static_cast<uint8_t>(edge >> 1);
+    state.eo[j] = static_cast<uint8_t>(edge & 1);
+  }
+  return validate(state);
+}
+
+StateError CubeFormat::parseFacelets(const char *text, size_t length,
+                                     CubeState &state) {
+  if (length != FACELET_LENGTH) {
+    return STATE_BAD_FORMAT;
+  }
+  const FormatTables &tables = formatTables();
+  FaceletCube cube;
+  uint8_t invalid = 0;
+  for (size_t i = 0; i < FACELET_LENGTH; i++) {
+    uint8_t color = tables.color[static_cast<uint8_t>(text[i])];
+    cube.facelets[i] = color;
+    invalid |= color; // 只有 NONE 会置位最高位
+  }
+  if (invalid & 0x80) {
+    return STATE_BAD_FORMAT;
+  }
+  return fromFacelets(cube, state);
+}
+
+void CubeFormat::formatFacelets(const CubeState &state, char *text) {
+  for (int f = 0; f < 6; f++) {
+    text[f * 9 + 4] = LETTERS[f];
+  }
+  for (int j = 0; j < 8; j++) {
+    const uint8_t *home = FaceletCube::CORNER_FACELETS[state.cp[j]];
+    for (int n = 0; n < 3; n++) {
+      text[FaceletCube::CORNER_FACELETS[j][(state.co[j] + n) % 3]] =
+          LETTERS[home[n] / 9];
+    }
+  }
+  for (int j = 0; j < 12; j++) {
+    const uint8_t *home = FaceletCube::EDGE_FACELETS[state.ep[j]];
+    for (int n = 0; n < 2; n++) {
+      text[FaceletCube::EDGE_FACELETS[j][(state.eo[j] + n) % 2]] =
+          LETTERS[home[n] / 9];
+    }
+  }
+}
+
+std::string CubeFormat::toFacelets(const CubeState &state) {
+  char text[FACELET_LENGTH];
+  formatFacelets(state, text);
+  return std::string(text, FACELET_LENGTH);
+}
+
+StateError CubeFormat::parseCubies(const char *text, size_t length,
+                                   CubeState &state) {
+  const FormatTables &tables = formatTables();
+  FaceletCube cube;
+  size_t offset = 0;
+  for (int piece = 0; piece < 20; piece++) {
+    const uint8_t *position =
+        piece < 12 ? CUBIE_EDGES[piece] : CUBIE_CORNERS[piece - 12];
+    size_t size = piece < 12 ? 2 : 3;
+
+    while (offset < length && isSpace(text[offset])) {
+      offset++;
+    }
+    size_t begin = offset;
+    while (offset < length && !isSpace(text[offset])) {
+      offset++;
+    }
+    if (offset - begin != size) {
+      return STATE_BAD_FORMAT;
+    }
+    for (size_t n = 0; n < size; n++) {
+      uint8_t color = tables.color[static_cast<uint8_t>(text[begin + n])];
+      if (color == NONE) {
+        return STATE_BAD_FORMAT;
+      }
+      cube.facelets[position[n]] = color;
+    }
+  }
+
+  while (offset < length && isSpace(text[offset])) {
+    offset++;
+  }
+  if (offset != length) {
+    return STATE_BAD_FORMAT;
+  }
+  return fromFacelets(cube, state);
+}
+
+void CubeFormat::formatCubies(const CubeState &state, char *text) {
+  FaceletCube cube = FaceletCube::fromState(state);
+  for (int piece = 0; piece < 20; piece++) {
+    const uint8_t *position =
+        piece < 12 ? CUBIE_EDGES[piece] : CUBIE_CORNERS[piece - 12];
+    int size = piece < 12 ? 2 : 3;
+    if (piece > 0) {
+      *text++ = ' ';
+    }
+    for (int n = 0; n < size; n++) {
+      *text++ = LETTERS[cube.facelets[position[n]]];
+    }
+  }
+}
+
+std::string CubeFormat::toCubies(const CubeState &state) {
+  char text[CUBIE_LENGTH];
+  formatCubies(state, text);
+  return std::string(text, CUBIE_LENGTH);
+}
+
+StateError CubeFormat::parse(const std::string &text, CubeState &state) {
+  for (char c : text) {
+    if (isSpace(c)) {
+      return parseCubies(text.data(), text.size(), state);
+    }
+  }
+  return parseFacelets(text.data(), text.size(), state);
+}
+
+size_t CubeFormat::parseFaceletLines(const char *text, size_t count,
+                                     CubeState *states, StateError *errors) {
+  size_t valid = 0;
+  for (size_t i = 0; i < count; i++) {
+    const char *line = text + i * LINE_LENGTH;
+    StateError error = line[FACELET_LENGTH] == '\n'
+                           ? parseFacelets(line, FACELET_LENGTH, states[i])
+                           : STATE_BAD_FORMAT;
+    if (errors) {
+      errors[i] = error;
+    }
+    valid += error == STATE_OK ? 1 : 0;
+  }
+  return valid;
+}
+
+void CubeFormat::formatFaceletLines(const CubeState *states, size_t count,
+                                    char *text) {
+  for (size_t i = 0; i < count; i++) {
+    char *line = text + i * LINE_LENGTH;
+    formatFacelets(states[i], line);
+    line[FACELET_LENGTH] = '\n';
+  }
+}
+
+const char *CubeFormat::errorName(StateError error) {
+  static const char *const NAMES[STATE_ERROR_COUNT] = {
+      "ok",
+      "bad format",
+      "bad center",
+      "bad corner",
+      "bad edge",
+      "duplicate corner",
+      "duplicate edge",
+      "corner twist",
+      "edge flip",
+      "parity",
+  };
+  return error >= 0 && error < STATE_ERROR_COUNT ? NAMES[error] : "unknown";
+}
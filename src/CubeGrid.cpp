@@ -0,0 +1,76 @@
+#include "CubeGrid.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+
+CubeGrid::CubeGrid(int columns, int rows, uint32_t seed, int threads)
+    : columns(std::max(1, columns)), rows(std::max(1, rows)), pool(threads) {
+  tiles.resize(static_cast<size_t>(this->columns) * this->rows);
+  for (size_t i = 0; i < tiles.size(); i++) {
+    Tile &tile = tiles[i];
+    tile.random.seed(seed + static_cast<uint32_t>(i));
+    tile.cube.reset(new RubiksCube());
+    tile.cube->setRandomSeed(seed + static_cast<uint32_t>(i));
+    tile.cube->setShowUI(false);
+
+    // 每个魔方换一个视角，避免整面墙看起来完全一样
+    std::uniform_int_distribution<> angle(-12, 12);
+    tile.cube->rotateByMouseDelta(static_cast<float>(angle(tile.random)),
+                                  static_cast<float>(angle(tile.random)));
+    queueRound(tile);
+  }
+}
+
+void CubeGrid::queueRound(Tile &tile) {
+  // 随机打乱（相邻两步不转同一面），接着按相反顺序逆转还原
+  std::uniform_int_distribution<> faceDist(0, 5);
+  std::uniform_int_distribution<> turnDist(1, 3);
+  Move round[2 * SCRAMBLE_MOVES];
+  int previous = -1;
+  for (int i = 0; i < SCRAMBLE_MOVES; i++) {
+    int face;
+    do {
+      face = faceDist(tile.random);
+    } while (face == previous);
+    previous = face;
+    round[i] = Move(static_cast<Face>(face), turnDist(tile.random));
+    round[2 * SCRAMBLE_MOVES - 1 - i] = round[i].inverse();
+  }
+  tile.cube->queueMoves(round, 2 * SCRAMBLE_MOVES);
+}
+
+void CubeGrid::update(std::chrono::nanoseconds elapsed) {
+  for (Tile &tile : tiles) {
+    if (tile.cube->isIdle()) {
+      // 空序列不改变状态，只把块的姿态对齐到整90度，消除逐步旋转的误差
+      tile.cube->applyMoves(nullptr, 0);
+      queueRound(tile);
+    }
+    tile.cube->update(elapsed);
+  }
+}
+
+void CubeGrid::draw(CellBuffer &buffer) {
+  buffer.clear();
+  int tileWidth = buffer.width() / columns;
+  int tileHeight = buffer.height() / rows;
+  if (tileWidth <= 0 || tileHeight <= 0) {
+    return;
+  }
+
+  // 单魔方视图在 80x40 的画面上使用缩放 25，格子按比例缩小并留出边距
+  float scale = 20.0f * std::min(tileWidth / 80.0f, tileHeight / 40.0f);
+
+  // 各格写入共享缓冲区中互不重叠的区域，不需要加锁
+  pool.run(tiles.size(), [&](size_t i) {
+    TRACE_SCOPE("tile");
+    Tile &tile = tiles[i];
+    if (tile.buffer.width() != tileWidth ||
+        tile.buffer.height() != tileHeight) {
+      tile.buffer.resize(tileWidth, tileHeight);
+    }
+    tile.cube->setScale(scale);
+    tile.cube->draw(tile.buffer);
+    buffer.blit(tile.buffer, static_cast<int>(i % columns) * tileWidth,
+                static_cast<int>(i / columns) * tileHeight);
+  });
+}
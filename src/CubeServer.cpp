@@ -0,0 +1,363 @@
+#include "CubeServer.hpp"
+#include "CubeProtocol.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+CubeServer::CubeServer(uint32_t seed, int solverThreads)
+    : listenFd(-1), epollFd(-1), seed(seed), sessionCount(0),
+      requestCount(0), moveCount(0),
+      wakeFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), solveStopping(false) {
+  if (solverThreads <= 0) {
+    solverThreads =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+  }
+  for (int i = 0; i < solverThreads; i++) {
+    solveThreads.emplace_back(&CubeServer::solveLoop, this);
+  }
+}
+
+CubeServer::~CubeServer() {
+  {
+    std::lock_guard<std::mutex> lock(solveMutex);
+    solveStopping = true;
+  }
+  solveReady.notify_all();
+  for (std::thread &thread : solveThreads) {
+    thread.join();
+  }
+
+  for (auto &entry : sessions) {
+    ::close(entry.first);
+  }
+  sessions.clear();
+  if (wakeFd >= 0) {
+    ::close(wakeFd);
+  }
+  if (epollFd >= 0) {
+    ::close(epollFd);
+  }
+  if (listenFd >= 0) {
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+  }
+}
+
+bool CubeServer::listen(const std::string &path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path) || wakeFd < 0) {
+    return false;
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listenFd < 0) {
+    return false;
+  }
+  ::unlink(path.c_str());
+  if (::bind(listenFd, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(listenFd, SOMAXCONN) != 0) {
+    ::close(listenFd);
+    listenFd = -1;
+    return false;
+  }
+  socketPath = path;
+
+  epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+  if (epollFd < 0) {
+    return false;
+  }
+  for (int fd : {listenFd, wakeFd}) {
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CubeServer::run(const std::atomic<bool> &stop) {
+  constexpr int MAX_EVENTS = 64;
+  epoll_event events[MAX_EVENTS];
+  while (!stop.load()) {
+    int count = ::epoll_wait(epollFd, events, MAX_EVENTS, 100);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    for (int i = 0; i < count; i++) {
+      int fd = events[i].data.fd;
+      if (fd == listenFd) {
+        acceptClients();
+        continue;
+      }
+      if (fd == wakeFd) {
+        uint64_t value;
+        while (::read(wakeFd, &value, sizeof(value)) > 0) {
+        }
+        finishSolves();
+        continue;
+      }
+      auto found = sessions.find(fd);
+      if (found == sessions.end()) {
+        continue;
+      }
+
+      // 先读完对端关闭前发来的数据，read 返回0时再关闭
+      Session &session = *found->second;
+      uint32_t flags = events[i].events;
+      bool open = (flags & (EPOLLIN | EPOLLOUT)) != 0;
+      if (open && (flags & EPOLLIN)) {
+        open = readRequests(session);
+      }
+      if (open && (flags & EPOLLOUT)) {
+        open = flushOutput(session);
+      }
+      if (!open) {
+        closeSession(fd);
+      }
+    }
+  }
+}
+
+void CubeServer::acceptClients() {
+  while (true) {
+    int fd = ::accept4(listenFd, nullptr, nullptr,
+                       SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      return; // EAGAIN：已接受完；其他错误留到下次事件再试
+    }
+
+    std::unique_ptr<Session> session(new Session());
+    session->fd = fd;
+    session->id = sessionCount;
+    session->cube.reset(new RubiksCube());
+    session->cube->setRandomSeed(seed + static_cast<uint32_t>(sessionCount));
+    session->written = 0;
+    session->writing = false;
+    session->solving = false;
+    session->events = EPOLLIN;
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = session->events;
+    event.data.fd = fd;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+      ::close(fd);
+      continue;
+    }
+    sessions[fd] = std::move(session);
+    sessionCount++;
+  }
+}
+
+bool CubeServer::readRequests(Session &session) {
+  // 每次事件只读一次，连接多时各连接轮流得到服务
+  uint8_t chunk[64 * 1024];
+  ssize_t received = ::read(session.fd, chunk, sizeof(chunk));
+  if (received == 0) {
+    return false;
+  }
+  if (received < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  }
+  session.input.insert(session.input.end(), chunk, chunk + received);
+  return processInput(session) && flushOutput(session);
+}
+
+bool CubeServer::processInput(Session &session) {
+  size_t offset = 0;
+  while (!session.solving &&
+         session.input.size() - offset >= CubeProtocol::HEADER_SIZE) {
+    const uint8_t *header = session.input.data() + offset;
+    size_t length = CubeProtocol::payloadLength(header);
+    if (length > CubeProtocol::MAX_PAYLOAD) {
+      return false;
+    }
+    if (session.input.size() - offset < CubeProtocol::HEADER_SIZE + length) {
+      break;
+    }
+    handleRequest(session, header[0], header + CubeProtocol::HEADER_SIZE,
+                  length);
+    offset += CubeProtocol::HEADER_SIZE + length;
+  }
+  session.input.erase(session.input.begin(), session.input.begin() + offset);
+  updateEvents(session);
+  return true;
+}
+
+void CubeServer::handleRequest(Session &session, int opcode,
+                               const uint8_t *payload, size_t length) {
+  std::vector<uint8_t> &output = session.output;
+  size_t start = output.size();
+  output.resize(start + CubeProtocol::HEADER_SIZE);
+  int status = STATUS_OK;
+  RubiksCube &cube = *session.cube;
+  requestCount++;
+
+  switch (opcode) {
+  case OP_APPLY:
+    // 整批转动合成一次块变换，与转动个数无关地只更新一遍块姿态
+    moves.clear();
+    for (size_t i = 0; i < length && status == STATUS_OK; i++) {
+      if (payload[i] >= Move::COUNT) {
+        status = STATUS_BAD_REQUEST;
+      } else {
+        moves.push_back(Move::fromIndex(payload[i]));
+      }
+    }
+    if (status == STATUS_OK) {
+      cube.applyMoves(moves);
+      moveCount += moves.size();
+    }
+    break;
+  case OP_STATE: {
+    CubeState state = cube.getState();
+    output.insert(output.end(), state.cp, state.cp + 8);
+    output.insert(output.end(), state.co, state.co + 8);
+    output.insert(output.end(), state.ep, state.ep + 12);
+    output.insert(output.end(), state.eo, state.eo + 12);
+    break;
+  }
+  case OP_RESET:
+    cube.reset();
+    break;
+  case OP_SCRAMBLE:
+    cube.scramble(length > 0 ? payload[0] : CubeProtocol::DEFAULT_SCRAMBLE);
+    break;
+  case OP_SOLVE:
+    // 响应在求解完成后由 finishSolves() 写入，在此之前不处理该连接的
+    // 后续请求
+    output.resize(start);
+    session.solving = true;
+    {
+      std::lock_guard<std::mutex> lock(solveMutex);
+      solveJobs.push_back(
+          SolveJob{session.fd, session.id, cube.getState(), {}});
+    }
+    solveReady.notify_one();
+    return;
+  default:
+    status = STATUS_UNKNOWN_OP;
+    break;
+  }
+
+  if (status != STATUS_OK) {
+    output.resize(start + CubeProtocol::HEADER_SIZE);
+  }
+  CubeProtocol::writeHeader(output.data() + start, status,
+                            output.size() - start - CubeProtocol::HEADER_SIZE);
+}
+
+void CubeServer::finishSolves() {
+  std::deque<SolveJob> finished;
+  {
+    std::lock_guard<std::mutex> lock(solveMutex);
+    finished.swap(solvedJobs);
+  }
+
+  for (SolveJob &job : finished) {
+    auto found = sessions.find(job.fd);
+    if (found == sessions.end() || found->second->id != job.sessionId) {
+      continue; // 连接已关闭
+    }
+    Session &session = *found->second;
+    size_t start = session.output.size();
+    session.output.resize(start + CubeProtocol::HEADER_SIZE);
+    CubeProtocol::writeHeader(session.output.data() + start, STATUS_OK,
+                              job.moves.size());
+    for (const Move &move : job.moves) {
+      session.output.push_back(static_cast<uint8_t>(move.index()));
+    }
+    session.solving = false;
+
+    // 继续处理求解期间已经收到的请求
+    if (!processInput(session) || !flushOutput(session)) {
+      closeSession(job.fd);
+    }
+  }
+}
+
+bool CubeServer::flushOutput(Session &session) {
+  while (session.written < session.output.size()) {
+    ssize_t sent = ::send(session.fd, session.output.data() + session.written,
+                          session.output.size() - session.written,
+                          MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        return false;
+      }
+      // 写不下去了：改为等待可写，期间不再读取新请求
+      session.writing = true;
+      updateEvents(session);
+      return true;
+    }
+    session.written += static_cast<size_t>(sent);
+  }
+
+  session.output.clear();
+  session.written = 0;
+  session.writing = false;
+  updateEvents(session);
+  return true;
+}
+
+void CubeServer::updateEvents(Session &session) {
+  // 等待可写时只关心可写；等待求解时什么都不关心（仍会收到挂断）
+  uint32_t events =
+      session.writing ? EPOLLOUT : (session.solving ? 0u : EPOLLIN);
+  if (events == session.events) {
+    return;
+  }
+  epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = events;
+  event.data.fd = session.fd;
+  ::epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &event);
+  session.events = events;
+}
+
+void CubeServer::closeSession(int fd) {
+  ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  ::close(fd);
+  sessions.erase(fd);
+}
+
+void CubeServer::solveLoop() {
+  std::unique_lock<std::mutex> lock(solveMutex);
+  while (true) {
+    solveReady.wait(lock,
+                    [this]() { return solveStopping || !solveJobs.empty(); });
+    if (solveStopping) {
+      return;
+    }
+    SolveJob job = std::move(solveJobs.front());
+    solveJobs.pop_front();
+    lock.unlock();
+
+    solver.solve(job.state, job.moves);
+
+    lock.lock();
+    solvedJobs.push_back(std::move(job));
+    uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written; // eventfd 计数饱和时写入失败也无妨，事件循环总会被唤醒
+  }
+}
@@ -0,0 +1,256 @@
+#include "CubeState.hpp"
+#include "RotationGroup.hpp"
+#include <cstring>
+#include <utility>
+
+const Face CubeState::CORNER_FACES[8][3] = {
+    {FACE_U, FACE_R, FACE_F}, {FACE_U, FACE_F, FACE_L},
+    {FACE_U, FACE_L, FACE_B}, {FACE_U, FACE_B, FACE_R},
+    {FACE_D, FACE_F, FACE_R}, {FACE_D, FACE_L, FACE_F},
+    {FACE_D, FACE_B, FACE_L}, {FACE_D, FACE_R, FACE_B}};
+
+const Face CubeState::EDGE_FACES[12][2] = {
+    {FACE_U, FACE_R}, {FACE_U, FACE_F}, {FACE_U, FACE_L}, {FACE_U, FACE_B},
+    {FACE_D, FACE_R}, {FACE_D, FACE_F}, {FACE_D, FACE_L}, {FACE_D, FACE_B},
+    {FACE_F, FACE_R}, {FACE_F, FACE_L}, {FACE_B, FACE_L}, {FACE_B, FACE_R}};
+
+namespace {
+
+const uint32_t FACTORIAL[13] = {1,       1,        2,        6,        24,
+                                120,     720,      5040,     40320,    362880,
+                                3628800, 39916800, 479001600};
+
+constexpr uint32_t TWIST_COUNT = 2187; // 3^7
+constexpr uint32_t FLIP_COUNT = 2048;  // 2^11
+
+int findCorner(const Vector3 &position) {
+  for (int i = 0; i < 8; i++) {
+    if (CubeState::cornerPosition(i) == position)
+      return i;
+  }
+  return -1;
+}
+
+int findEdge(const Vector3 &position) {
+  for (int i = 0; i < 12; i++) {
+    if (CubeState::edgePosition(i) == position)
+      return i;
+  }
+  return -1;
+}
+
+// 由面转动的几何旋转推导18个转动状态
+struct MoveStates {
+  CubeState states[Move::COUNT];
+
+  MoveStates() {
+    for (int m = 0; m < Move::COUNT; m++) {
+      Move move = Move::fromIndex(m);
+      Face face = static_cast<Face>(move.face);
+      Vector3 axis = Move::faceAxis(face);
+      int turn = RotationGroup::faceTurn(face, move.turns);
+      CubeState &state = states[m];
+
+      for (int i = 0; i < 8; i++) {
+        Vector3 position = CubeState::cornerPosition(i);
+        if (position.dot(axis) < 0.5f)
+          continue;
+
+        int j = findCorner(RotationGroup::apply(turn, position));
+        Vector3 reference = RotationGroup::apply(
+            turn, Move::faceAxis(CubeState::CORNER_FACES[i][0]));
+        state.cp[j] = static_cast<uint8_t>(i);
+        for (int k = 0; k < 3; k++) {
+          if (Move::faceAxis(CubeState::CORNER_FACES[j][k]) == reference)
+            state.co[j] = static_cast<uint8_t>(k);
+        }
+      }
+
+      for (int i = 0; i < 12; i++) {
+        Vector3 position = CubeState::edgePosition(i);
+        if (position.dot(axis) < 0.5f)
+          continue;
+
+        int j = findEdge(RotationGroup::apply(turn, position));
+        Vector3 reference = RotationGroup::apply(
+            turn, Move::faceAxis(CubeState::EDGE_FACES[i][0]));
+        state.ep[j] = static_cast<uint8_t>(i);
+        state.eo[j] =
+            Move::faceAxis(CubeState::EDGE_FACES[j][0]) == reference ? 0 : 1;
+      }
+    }
+  }
+};
+
+const MoveStates &moveStates() {
+  static const MoveStates instance;
+  return instance;
+}
+
+} // namespace
+
+CubeState::CubeState() {
+  for (int i = 0; i < 8; i++) {
+    cp[i] = static_cast<uint8_t>(i);
+    co[i] = 0;
+  }
+  for (int i = 0; i < 12; i++) {
+    ep[i] = static_cast<uint8_t>(i);
+    eo[i] = 0;
+  }
+}
+
+const CubeState &CubeState::moveState(const Move &move) {
+  return moveStates().states[move.index()];
+}
+
+CubeState CubeState::multiply(const CubeState &a, const CubeState &b) {
+  static const uint8_t MOD3[6] = {0, 1, 2, 0, 1, 2};
+
+  CubeState result;
+  for (int i = 0; i < 8; i++) {
+    result.cp[i] = a.cp[b.cp[i]];
+    result.co[i] = MOD3[a.co[b.cp[i]] + b.co[i]];
+  }
+  for (int i = 0; i < 12; i++) {
+    result.ep[i] = a.ep[b.ep[i]];
+    result.eo[i] = a.eo[b.ep[i]] ^ b.eo[i];
+  }
+  return result;
+}
+
+void CubeState::apply(const Move &move) {
+  *this = multiply(*this, moveState(move));
+}
+
+void CubeState::applyMoves(const Move *moves, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    apply(moves[i]);
+  }
+}
+
+CubeState CubeState::inverse() const {
+  CubeState result;
+  for (int i = 0; i < 8; i++) {
+    result.cp[cp[i]] = static_cast<uint8_t>(i);
+    result.co[cp[i]] = static_cast<uint8_t>((3 - co[i]) % 3);
+  }
+  for (int i = 0; i < 12; i++) {
+    result.ep[ep[i]] = static_cast<uint8_t>(i);
+    result.eo[ep[i]] = eo[i];
+  }
+  return result;
+}
+
+bool CubeState::isSolved() const { return *this == CubeState(); }
+
+StateCode CubeState::encode() const {
+  uint32_t twist = 0;
+  for (int i = 0; i < 7; i++) {
+    twist = twist * 3 + co[i];
+  }
+
+  uint64_t flip = 0;
+  for (int i = 0; i < 11; i++) {
+    flip = flip * 2 + eo[i];
+  }
+
+  StateCode code;
+  code.corners = rankPermutation(cp, 8) * TWIST_COUNT + twist;
+  code.edges = static_cast<uint64_t>(rankPermutation(ep, 12) / 2) * FLIP_COUNT +
+               flip;
+  return code;
+}
+
+CubeState CubeState::decode(const StateCode &code) {
+  CubeState state;
+
+  uint32_t twist = code.corners % TWIST_COUNT;
+  int cornerParity =
+      unrankPermutation(code.corners / TWIST_COUNT, state.cp, 8);
+  int twistSum = 0;
+  for (int i = 6; i >= 0; i--) {
+    state.co[i] = static_cast<uint8_t>(twist % 3);
+    twistSum += state.co[i];
+    twist /= 3;
+  }
+  state.co[7] = static_cast<uint8_t>((3 - twistSum % 3) % 3);
+
+  uint64_t flip = code.edges % FLIP_COUNT;
+  int flipSum = 0;
+  for (int i = 10; i >= 0; i--) {
+    state.eo[i] = static_cast<uint8_t>(flip & 1);
+    flipSum += state.eo[i];
+    flip >>= 1;
+  }
+  state.eo[11] = static_cast<uint8_t>(flipSum & 1);
+
+  // 秩 2k 与 2k+1 的排列只差最后两个元素的交换，奇偶性相反，
+  // 用角块奇偶性选出正确的那个
+  uint32_t edgeRank = static_cast<uint32_t>(code.edges / FLIP_COUNT) * 2;
+  if (unrankPermutation(edgeRank, state.ep, 12) != cornerParity) {
+    std::swap(state.ep[10], state.ep[11]);
+  }
+
+  return state;
+}
+
+Vector3 CubeState::cornerPosition(int corner) {
+  const Face *faces = CORNER_FACES[corner];
+  return Move::faceAxis(faces[0]) + Move::faceAxis(faces[1]) +
+         Move::faceAxis(faces[2]);
+}
+
+Vector3 CubeState::edgePosition(int edge) {
+  return Move::faceAxis(EDGE_FACES[edge][0]) +
+         Move::faceAxis(EDGE_FACES[edge][1]);
+}
+
+uint32_t CubeState::rankPermutation(const uint8_t *perm, int n) {
+  uint32_t rank = 0;
+  for (int i = 0; i < n - 1; i++) {
+    uint32_t smaller = 0;
+    for (int j = i + 1; j < n; j++) {
+      smaller += perm[j] < perm[i];
+    }
+    rank += smaller * FACTORIAL[n - 1 - i];
+  }
+  return rank;
+}
+
+int CubeState::unrankPermutation(uint32_t rank, uint8_t *perm, int n) {
+  // 排列的奇偶性等于 Lehmer 码各位之和的奇偶性，顺带求出
+  uint32_t digitSum = 0;
+
+  // 剩余元素按升序以4位一组压缩在64位整数中，取出和删除都无需分支
+  uint64_t available = 0xBA9876543210ULL;
+
+  for (int i = 0; i < n; i++) {
+    uint32_t index = rank / FACTORIAL[n - 1 - i];
+    rank %= FACTORIAL[n - 1 - i];
+
+    digitSum += index;
+    int shift = static_cast<int>(index) * 4;
+    perm[i] = static_cast<uint8_t>((available >> shift) & 0xF);
+    uint64_t lowMask = (1ULL << shift) - 1;
+    available = (available & lowMask) | ((available >> 4) & ~lowMask);
+  }
+  return static_cast<int>(digitSum & 1);
+}
+
+int CubeState::permutationParity(const uint8_t *perm, int n) {
+  int parity = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      parity ^= perm[i] > perm[j];
+    }
+  }
+  return parity;
+}
+
+bool CubeState::operator==(const CubeState &other) const {
+  return std::memcmp(cp, other.cp, sizeof(cp)) == 0 &&
+         std::memcmp(co, other.co, sizeof(co)) == 0 &&
+         std::memcmp(ep, other.ep, sizeof(ep)) == 0 &&
+         std::memcmp(eo, other.eo, sizeof(eo)) == 0;
+}
@@ -0,0 +1,179 @@
+#include "CubeSymmetry.hpp"
+#include "RotationGroup.hpp"
+
+namespace {
+
+Vector3 transform(int symmetry, const Vector3 &vec) {
+  Vector3 rotated =
+      RotationGroup::apply(symmetry % RotationGroup::SIZE, vec);
+  return CubeSymmetry::isMirror(symmetry) ? -rotated : rotated;
+}
+
+// 每个对称对角块/棱块位置的作用：目标位置，以及参考贴纸落在目标位置的第几个贴纸
+struct Tables {
+  uint8_t cornerSlot[CubeSymmetry::COUNT][8];
+  uint8_t cornerOffset[CubeSymmetry::COUNT][8];
+  uint8_t edgeSlot[CubeSymmetry::COUNT][12];
+  uint8_t edgeOffset[CubeSymmetry::COUNT][12];
+  uint8_t moves[CubeSymmetry::COUNT][Move::COUNT];
+
+  Tables() {
+    for (int s = 0; s < CubeSymmetry::COUNT; s++) {
+      for (int i = 0; i < 8; i++) {
+        Vector3 position = transform(s, CubeState::cornerPosition(i));
+        Vector3 reference =
+            transform(s, Move::faceAxis(CubeState::CORNER_FACES[i][0]));
+        for (int j = 0; j < 8; j++) {
+          if (!(CubeState::cornerPosition(j) == position))
+            continue;
+          cornerSlot[s][i] = static_cast<uint8_t>(j);
+          for (int k = 0; k < 3; k++) {
+            if (Move::faceAxis(CubeState::CORNER_FACES[j][k]) == reference)
+              cornerOffset[s][i] = static_cast<uint8_t>(k);
+          }
+        }
+      }
+
+      for (int i = 0; i < 12; i++) {
+        Vector3 position = transform(s, CubeState::edgePosition(i));
+        Vector3 reference =
+            transform(s, Move::faceAxis(CubeState::EDGE_FACES[i][0]));
+        for (int j = 0; j < 12; j++) {
+          if (!(CubeState::edgePosition(j) == position))
+            continue;
+          edgeSlot[s][i] = static_cast<uint8_t>(j);
+          edgeOffset[s][i] =
+              Move::faceAxis(CubeState::EDGE_FACES[j][0]) == reference ? 0 : 1;
+        }
+      }
+    }
+
+    // 转动的共轭仍是一个面转动，与18个转动状态逐一比对即可
+    for (int s = 0; s < CubeSymmetry::COUNT; s++) {
+      for (int m = 0; m < Move::COUNT; m++) {
+        CubeState conjugated =
+            conjugate(CubeState::moveState(Move::fromIndex(m)), s);
+        for (int n = 0; n < Move::COUNT; n++) {
+          if (CubeState::moveState(Move::fromIndex(n)) == conjugated)
+            moves[s][m] = static_cast<uint8_t>(n);
+        }
+      }
+    }
+  }
+
+  void conjugateCorners(const CubeState &state, int s, uint8_t *cp,
+                        uint8_t *co) const {
+    const uint8_t *slot = cornerSlot[s];
+    const uint8_t *offset = cornerOffset[s];
+    const bool mirror = CubeSymmetry::isMirror(s);
+    for (int i = 0; i < 8; i++) {
+      int twist = mirror ? 3 - state.co[i] : state.co[i];
+      cp[slot[i]] = slot[state.cp[i]];
+      co[slot[i]] =
+          static_cast<uint8_t>((offset[i] + twist + 3 - offset[state.cp[i]]) % 3);
+    }
+  }
+
+  CubeState conjugate(const CubeState &state, int s) const {
+    CubeState result;
+    conjugateCorners(state, s, result.cp, result.co);
+
+    const uint8_t *slot = edgeSlot[s];
+    const uint8_t *offset = edgeOffset[s];
+    for (int i = 0; i < 12; i++) {
+      result.ep[slot[i]] = slot[state.ep[i]];
+      result.eo[slot[i]] = offset[i] ^ state.eo[i] ^ offset[state.ep[i]];
+    }
+    return result;
+  }
+};
+
+const Tables &tables() {
+  static const Tables instance;
+  return instance;
+}
+
+uint32_t cornerCode(const uint8_t *cp, const uint8_t *co) {
+  uint32_t twist = 0;
+  for (int i = 0; i < 7; i++) {
+    twist = twist * 3 + co[i];
+  }
+  return CubeState::rankPermutation(cp, 8) * 2187 + twist;
+}
+
+} // namespace
+
+CubeState CubeSymmetry::conjugate(const CubeState &state, int symmetry) {
+  return tables().conjugate(state, symmetry);
+}
+
+CubeState CubeSymmetry::canonicalize(const CubeState &state, int *symmetry) {
+  int best = IDENTITY;
+  canonicalCode(state, &best);
+  if (symmetry) {
+    *symmetry = best;
+  }
+  return conjugate(state, best);
+}
+
+StateCode CubeSymmetry::canonicalCode(const CubeState &state, int *symmetry) {
+  const Tables &t = tables();
+
+  // 第一轮：只计算角块坐标，记录取得最小值的对称
+  uint32_t bestCorners = StateCode::CORNER_COUNT;
+  int candidates[COUNT];
+  int candidateCount = 0;
+  for (int s = 0; s < COUNT; s++) {
+    uint8_t cp[8], co[8];
+    t.conjugateCorners(state, s, cp, co);
+    uint32_t corners = cornerCode(cp, co);
+    if (corners < bestCorners) {
+      bestCorners = corners;
+      candidateCount = 0;
+    }
+    if (corners == bestCorners) {
+      candidates[candidateCount++] = s;
+    }
+  }
+
+  // 第二轮：在角块并列的对称中比较完整编码
+  StateCode best = t.conjugate(state, candidates[0]).encode();
+  int bestSymmetry = candidates[0];
+  for (int i = 1; i < candidateCount; i++) {
+    StateCode code = t.conjugate(state, candidates[i]).encode();
+    if (code < best) {
+      best = code;
+      bestSymmetry = candidates[i];
+    }
+  }
+
+  if (symmetry) {
+    *symmetry = bestSymmetry;
+  }
+  return best;
+}
+
+Move CubeSymmetry::conjugateMove(const Move &move, int symmetry) {
+  return Move::fromIndex(tables().moves[symmetry][move.index()]);
+}
+
+int CubeSymmetry::inverse(int symmetry) {
+  int rotation = RotationGroup::inverse(symmetry % RotationGroup::SIZE);
+  return isMirror(symmetry) ? rotation + RotationGroup::SIZE : rotation;
+}
+
+int CubeSymmetry::multiply(int a, int b) {
+  int rotation = RotationGroup::multiply(a % RotationGroup::SIZE,
+                                         b % RotationGroup::SIZE);
+  return isMirror(a) != isMirror(b) ? rotation + RotationGroup::SIZE
+                                    : rotation;
+}
+
+int CubeSymmetry::stabilizerSize(const CubeState &state) {
+  int count = 0;
+  for (int s = 0; s < COUNT; s++) {
+    if (conjugate(state, s) == state)
+      count++;
+  }
+  return count;
+}
@@ -0,0 +1,33 @@
+#include "CursesRenderer.hpp"
+
+#ifdef _WIN32
+#include <pdcurses.h>
+#else
+#include <curses.h>
+#endif
+
+void CursesRenderer::present(const CellBuffer &buffer) {
+  for (int y = 0; y < buffer.height(); y++) {
+    for (int x = 0; x < buffer.width(); x++) {
+      const Cell &cell = buffer.at(x, y);
+      int colorPair = 0;
+      if (cell.color >= 0) {
+        auto it = colorCache.find(cell.color);
+        if (it != colorCache.end()) {
+          colorPair = it->second;
+        } else {
+          colorPair = static_cast<int>(colorCache.size()) + 1;
+          init_pair(colorPair, cell.color, COLOR_BLACK);
+          colorCache[cell.color] = colorPair;
+        }
+      }
+      chtype attr = cell.attr & CellBuffer::ATTR_REVERSE ? A_REVERSE : 0;
+      mvaddch(y, x,
+              static_cast<chtype>(static_cast<unsigned char>(cell.ch)) |
+                  COLOR_PAIR(colorPair) | attr);
+    }
+  }
+  refresh();
+}
+
+void CursesRenderer::invalidate() { clearok(stdscr, TRUE); }
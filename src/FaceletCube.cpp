@@ -0,0 +1,334 @@
+#include "FaceletCube.hpp"
+#include <cstring>
+#include <vector>
+
+// 只有 GCC/Clang 的 x86 目标才编译 SIMD 实现：各函数用 target 属性单独
+// 开启指令集，运行时按 CPU 支持情况选择，整个文件仍按基线指令集编译
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FACELET_X86
+#include <immintrin.h>
+#endif
+
+const uint8_t FaceletCube::CORNER_FACELETS[8][3] = {
+    {8, 9, 20},   {6, 18, 38},  {0, 36, 47},  {2, 45, 11},
+    {29, 26, 15}, {27, 44, 24}, {33, 53, 42}, {35, 17, 51}};
+
+const uint8_t FaceletCube::EDGE_FACELETS[12][2] = {
+    {5, 10},  {7, 19},  {3, 37},  {1, 46},  {32, 16}, {28, 25},
+    {30, 43}, {34, 52}, {23, 12}, {21, 41}, {50, 39}, {48, 14}};
+
+namespace {
+
+constexpr uint8_t ZERO_LANE = 0x80; // pshufb 掩码最高位为1时输出0
+
+/**
+ * @brief 把块级状态展开为贴纸序号：还原状态下位于 result[i] 的贴纸，
+ *        在该状态下位于 i
+ */
+void stateFacelets(const CubeState &state, uint8_t *result) {
+  for (int i = 0; i < FaceletCube::BYTES; i++) {
+    result[i] = static_cast<uint8_t>(i); // 中心与填充不动
+  }
+  for (int j = 0; j < 8; j++) {
+    for (int n = 0; n < 3; n++) {
+      result[FaceletCube::CORNER_FACELETS[j][(state.co[j] + n) % 3]] =
+          FaceletCube::CORNER_FACELETS[state.cp[j]][n];
+    }
+  }
+  for (int j = 0; j < 12; j++) {
+    for (int n = 0; n < 2; n++) {
+      result[FaceletCube::EDGE_FACELETS[j][(state.eo[j] + n) % 2]] =
+          FaceletCube::EDGE_FACELETS[state.ep[j]][n];
+    }
+  }
+}
+
+/**
+ * @struct ShuffleTables
+ * @brief 每种面转动的置换及各指令集使用的重排掩码
+ */
+struct ShuffleTables {
+  /// 置换本身（标量与 vpermb 使用）
+  alignas(64) uint8_t perm[Move::COUNT][FaceletCube::BYTES];
+  /// [转动][输出寄存器 × 4 + 源寄存器]：pshufb 掩码
+  alignas(64) uint8_t sse[Move::COUNT][16][16];
+  /// [转动][输出寄存器 × 4 + 源寄存器 × 2 + 是否交换两半]：vpshufb 掩码
+  alignas(64) uint8_t avx[Move::COUNT][8][32];
+
+  ShuffleTables() {
+    for (int m = 0; m < Move::COUNT; m++) {
+      stateFacelets(CubeState::moveState(Move::fromIndex(m)), perm[m]);
+
+      // 输出的每个字节只在取自的那个源寄存器的掩码里有效，其余置 0x80，
+      // 各源寄存器的重排结果按位或起来即为输出
+      std::memset(sse[m], ZERO_LANE, sizeof(sse[m]));
+      std::memset(avx[m], ZERO_LANE, sizeof(avx[m]));
+      for (int i = 0; i < FaceletCube::BYTES; i++) {
+        int source = perm[m][i];
+        sse[m][(i >> 4) * 4 + (source >> 4)][i & 15] =
+            static_cast<uint8_t>(source & 15);
+
+        // vpshufb 只在各自的 128 位内取字节：取自另一半的字节改从
+        // 交换了两半的副本中取
+        int swapped = ((source >> 4) & 1) != ((i >> 4) & 1) ? 1 : 0;
+        avx[m][(i >> 5) * 4 + (source >> 5) * 2 + swapped][i & 31] =
+            static_cast<uint8_t>(source & 15);
+      }
+    }
+  }
+};
+
+const ShuffleTables &shuffleTables() {
+  static const ShuffleTables instance;
+  return instance;
+}
+
+/// 处理一段魔方：第 n 个魔方执行 moves[n * stride] 起的 moveCount 步
+using KernelFunction = void (*)(FaceletCube *cubes, size_t count,
+                                const uint8_t *moves, size_t moveCount,
+                                size_t stride);
+
+void applyScalar(FaceletCube *cubes, size_t count, const uint8_t *moves,
+                 size_t moveCount, size_t stride) {
+  const ShuffleTables &tables = shuffleTables();
+  uint8_t next[FaceletCube::FACELETS];
+  for (size_t n = 0; n < count; n++) {
+    uint8_t *facelets = cubes[n].facelets;
+    const uint8_t *sequence = moves + n * stride;
+    for (size_t k = 0; k < moveCount; k++) {
+      const uint8_t *perm = tables.perm[sequence[k]];
+      for (int i = 0; i < FaceletCube::FACELETS; i++) {
+        next[i] = facelets[perm[i]];
+      }
+      std::memcpy(facelets, next, sizeof(next));
+    }
+  }
+}
+
+#ifdef FACELET_X86
+
+__attribute__((target("ssse3"))) void
+applySsse3(FaceletCube *cubes, size_t count, const uint8_t *moves,
+           size_t moveCount, size_t stride) {
+  const ShuffleTables &tables = shuffleTables();
+  for (size_t n = 0; n < count; n++) {
+    __m128i *data = reinterpret_cast<__m128i *>(cubes[n].facelets);
+    __m128i r0 = _mm_load_si128(data);
+    __m128i r1 = _mm_load_si128(data + 1);
+    __m128i r2 = _mm_load_si128(data + 2);
+    __m128i r3 = _mm_load_si128(data + 3);
+    const uint8_t *sequence = moves + n * stride;
+    for (size_t k = 0; k < moveCount; k++) {
+      const __m128i *mask =
+          reinterpret_cast<const __m128i *>(tables.sse[sequence[k]]);
+      __m128i out[4];
+      for (int r = 0; r < 4; r++) {
+        const __m128i *row = mask + r * 4;
+        out[r] = _mm_or_si128(
+            _mm_or_si128(_mm_shuffle_epi8(r0, _mm_load_si128(row)),
+                         _mm_shuffle_epi8(r1, _mm_load_si128(row + 1))),
+            _mm_or_si128(_mm_shuffle_epi8(r2, _mm_load_si128(row + 2)),
+                         _mm_shuffle_epi8(r3, _mm_load_si128(row + 3))));
+      }
+      r0 = out[0];
+      r1 = out[1];
+      r2 = out[2];
+      r3 = out[3];
+    }
+    _mm_store_si128(data, r0);
+    _mm_store_si128(data + 1, r1);
+    _mm_store_si128(data + 2, r2);
+    _mm_store_si128(data + 3, r3);
+  }
+}
+
+__attribute__((target("avx2"))) void
+applyAvx2(FaceletCube *cubes, size_t count, const uint8_t *moves,
+          size_t moveCount, size_t stride) {
+  const ShuffleTables &tables = shuffleTables();
+  for (size_t n = 0; n < count; n++) {
+    __m256i *data = reinterpret_cast<__m256i *>(cubes[n].facelets);
+    __m256i low = _mm256_load_si256(data);
+    __m256i high = _mm256_load_si256(data + 1);
+    const uint8_t *sequence = moves + n * stride;
+    for (size_t k = 0; k < moveCount; k++) {
+      const __m256i *mask =
+          reinterpret_cast<const __m256i *>(tables.avx[sequence[k]]);
+      __m256i lowSwapped = _mm256_permute2x128_si256(low, low, 0x01);
+      __m256i highSwapped = _mm256_permute2x128_si256(high, high, 0x01);
+      __m256i out[2];
+      for (int r = 0; r < 2; r++) {
+        const __m256i *row = mask + r * 4;
+        out[r] = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_shuffle_epi8(low, _mm256_load_si256(row)),
+                _mm256_shuffle_epi8(lowSwapped, _mm256_load_si256(row + 1))),
+            _mm256_or_si256(
+                _mm256_shuffle_epi8(high, _mm256_load_si256(row + 2)),
+                _mm256_shuffle_epi8(highSwapped,
+                                    _mm256_load_si256(row + 3))));
+      }
+      low = out[0];
+      high = out[1];
+    }
+    _mm256_store_si256(data, low);
+    _mm256_store_si256(data + 1, high);
+  }
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) void
+applyAvx512(FaceletCube *cubes, size_t count, const uint8_t *moves,
+            size_t moveCount, size_t stride) {
+  const ShuffleTables &tables = shuffleTables();
+  // 每步只有一条 vpermb，瓶颈是前后两步之间的延迟：同时推进四个魔方
+  size_t n = 0;
+  for (; n + 4 <= count; n += 4) {
+    __m512i c0 = _mm512_load_si512(cubes[n].facelets);
+    __m512i c1 = _mm512_load_si512(cubes[n + 1].facelets);
+    __m512i c2 = _mm512_load_si512(cubes[n + 2].facelets);
+    __m512i c3 = _mm512_load_si512(cubes[n + 3].facelets);
+    const uint8_t *s0 = moves + n * stride;
+    const uint8_t *s1 = s0 + stride;
+    const uint8_t *s2 = s1 + stride;
+    const uint8_t *s3 = s2 + stride;
+    for (size_t k = 0; k < moveCount; k++) {
+      c0 = _mm512_permutexvar_epi8(_mm512_load_si512(tables.perm[s0[k]]), c0);
+      c1 = _mm512_permutexvar_epi8(_mm512_load_si512(tables.perm[s1[k]]), c1);
+      c2 = _mm512_permutexvar_epi8(_mm512_load_si512(tables.perm[s2[k]]), c2);
+      c3 = _mm512_permutexvar_epi8(_mm512_load_si512(tables.perm[s3[k]]), c3);
+    }
+    _mm512_store_si512(cubes[n].facelets, c0);
+    _mm512_store_si512(cubes[n + 1].facelets, c1);
+    _mm512_store_si512(cubes[n + 2].facelets, c2);
+    _mm512_store_si512(cubes[n + 3].facelets, c3);
+  }
+  for (; n < count; n++) {
+    __m512i cube = _mm512_load_si512(cubes[n].facelets);
+    const uint8_t *sequence = moves + n * stride;
+    for (size_t k = 0; k < moveCount; k++) {
+      cube = _mm512_permutexvar_epi8(
+          _mm512_load_si512(tables.perm[sequence[k]]), cube);
+    }
+    _mm512_store_si512(cubes[n].facelets, cube);
+  }
+}
+
+const KernelFunction KERNELS[KERNEL_COUNT] = {applyScalar, applySsse3,
+                                              applyAvx2, applyAvx512};
+
+#else
+
+const KernelFunction KERNELS[KERNEL_COUNT] = {applyScalar, nullptr, nullptr,
+                                              nullptr};
+
+#endif
+
+} // namespace
+
+FaceletCube::FaceletCube() {
+  for (int i = 0; i < BYTES; i++) {
+    facelets[i] = static_cast<uint8_t>(i < FACELETS ? i / 9 : 0);
+  }
+}
+
+FaceletCube FaceletCube::fromState(const CubeState &state) {
+  uint8_t source[BYTES];
+  stateFacelets(state, source);
+  FaceletCube cube;
+  for (int i = 0; i < FACELETS; i++) {
+    cube.facelets[i] = static_cast<uint8_t>(source[i] / 9);
+  }
+  return cube;
+}
+
+void FaceletCube::apply(const Move &move) {
+  uint8_t index = static_cast<uint8_t>(move.index());
+  applyScalar(this, 1, &index, 1, 0);
+}
+
+const uint8_t *FaceletCube::permutation(const Move &move) {
+  return shuffleTables().perm[move.index()];
+}
+
+bool FaceletCube::isSolved() const {
+  for (int i = 0; i < FACELETS; i++) {
+    if (facelets[i] != facelets[i / 9 * 9 + 4]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FaceletCube::operator==(const FaceletCube &other) const {
+  return std::memcmp(facelets, other.facelets, FACELETS) == 0;
+}
+
+bool FaceletBatch::isSupported(FaceletKernel kernel) {
+  if (kernel < 0 || kernel >= KERNEL_COUNT || !KERNELS[kernel]) {
+    return false;
+  }
+#ifdef FACELET_X86
+  switch (kernel) {
+  case KERNEL_SSSE3:
+    return __builtin_cpu_supports("ssse3");
+  case KERNEL_AVX2:
+    return __builtin_cpu_supports("avx2");
+  case KERNEL_AVX512:
+    return __builtin_cpu_supports("avx512bw") &&
+           __builtin_cpu_supports("avx512vbmi");
+  default:
+    break;
+  }
+#endif
+  return true;
+}
+
+FaceletKernel FaceletBatch::bestKernel() {
+  static const FaceletKernel best = []() {
+    int kernel = KERNEL_COUNT - 1;
+    while (kernel > KERNEL_SCALAR &&
+           !isSupported(static_cast<FaceletKernel>(kernel))) {
+      kernel--;
+    }
+    return static_cast<FaceletKernel>(kernel);
+  }();
+  return best;
+}
+
+const char *FaceletBatch::kernelName(FaceletKernel kernel) {
+  static const char *const NAMES[KERNEL_COUNT] = {"scalar", "ssse3", "avx2",
+                                                  "avx512"};
+  return kernel >= 0 && kernel < KERNEL_COUNT ? NAMES[kernel] : "unknown";
+}
+
+void FaceletBatch::applyAll(ThreadPool &pool, FaceletCube *cubes,
+                            size_t count, const Move *moves, size_t moveCount,
+                            FaceletKernel kernel) {
+  std::vector<uint8_t> indices(moveCount);
+  for (size_t k = 0; k < moveCount; k++) {
+    indices[k] = static_cast<uint8_t>(moves[k].index());
+  }
+  run(pool, cubes, count, indices.data(), moveCount, 0, kernel);
+}
+
+void FaceletBatch::applyEach(ThreadPool &pool, FaceletCube *cubes,
+                             size_t count, const uint8_t *moveIndices,
+                             size_t movesPerCube, FaceletKernel kernel) {
+  run(pool, cubes, count, moveIndices, movesPerCube, movesPerCube, kernel);
+}
+
+void FaceletBatch::run(ThreadPool &pool, FaceletCube *cubes, size_t count,
+                       const uint8_t *moveIndices, size_t moveCount,
+                       size_t stride, FaceletKernel kernel) {
+  KernelFunction function =
+      isSupported(kernel) ? KERNELS[kernel] : KERNELS[KERNEL_SCALAR];
+  shuffleTables(); // 在工作线程开始前构造掩码表
+
+  size_t chunks = (count + CHUNK - 1) / CHUNK;
+  pool.run(chunks, [&](size_t chunk) {
+    size_t begin = chunk * CHUNK;
+    size_t end = begin + CHUNK < count ? begin + CHUNK : count;
+    function(cubes + begin, end - begin, moveIndices + begin * stride,
+             moveCount, stride);
+  });
+}
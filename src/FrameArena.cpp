@@ -0,0 +1,58 @@
+#include "FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t blockSize)
+    : current(0), offset(0), used(0), grows(0) {
+  blocks.push_back(
+      {std::unique_ptr<unsigned char[]>(new unsigned char[blockSize]),
+       blockSize});
+}
+
+void *FrameArena::allocate(size_t bytes, size_t alignment) {
+  while (true) {
+    Block &block = blocks[current];
+    uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+    uintptr_t aligned = (base + offset + alignment - 1) & ~(alignment - 1);
+    size_t end = aligned - base + bytes;
+    if (end <= block.size) {
+      offset = end;
+      return reinterpret_cast<void *>(aligned);
+    }
+
+    // 当前块放不下，换到下一块（没有就追加一块足够大的）
+    used += offset;
+    offset = 0;
+    current++;
+    if (current == blocks.size()) {
+      size_t size = std::max(blocks.back().size, bytes + alignment);
+      grows++;
+      blocks.push_back(
+          {std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+    }
+  }
+}
+
+void FrameArena::reset() {
+  if (blocks.size() > 1) {
+    // 合并成一个块，下一帧起一个块就能放下同样多的数据
+    size_t total = capacity();
+    grows++;
+    blocks.clear();
+    blocks.push_back(
+        {std::unique_ptr<unsigned char[]>(new unsigned char[total]), total});
+  }
+  current = 0;
+  offset = 0;
+  used = 0;
+}
+
+size_t FrameArena::bytesUsed() const { return used + offset; }
+
+size_t FrameArena::capacity() const {
+  size_t total = 0;
+  for (const Block &block : blocks) {
+    total += block.size;
+  }
+  return total;
+}
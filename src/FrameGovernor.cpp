@@ -0,0 +1,62 @@
+#include "FrameGovernor.hpp"
+
+FrameGovernor::FrameGovernor()
+    : currentLevel(QUALITY_FULL), adaptive(false), budgetMicros(16000.0),
+      quietWindows(0), historyCursor(0), historyCount(0) {
+  resetWindow();
+}
+
+void FrameGovernor::setAdaptive(double budgetMicros) {
+  this->budgetMicros = budgetMicros;
+  adaptive = true;
+  quietWindows = 0;
+  resetWindow();
+}
+
+void FrameGovernor::setLevel(QualityLevel level) {
+  currentLevel = level;
+  adaptive = false;
+}
+
+void FrameGovernor::resetWindow() {
+  windowFrames = 0;
+  overBudget = 0;
+  windowBusy = false;
+}
+
+void FrameGovernor::record(double micros, bool dropped) {
+  history[historyCursor] = static_cast<float>(micros);
+  historyCursor = (historyCursor + 1) % HISTORY;
+  historyCount = historyCount < HISTORY ? historyCount + 1 : HISTORY;
+  if (!adaptive) {
+    return;
+  }
+
+  windowFrames++;
+  overBudget += dropped || micros > budgetMicros ? 1 : 0;
+  windowBusy = windowBusy || dropped || micros > budgetMicros * 0.5;
+  if (windowFrames < WINDOW) {
+    return;
+  }
+
+  if (overBudget * 4 > WINDOW) {
+    if (currentLevel + 1 < QUALITY_COUNT) {
+      currentLevel = static_cast<QualityLevel>(currentLevel + 1);
+    }
+    quietWindows = 0;
+  } else if (!windowBusy) {
+    if (++quietWindows >= UP_WINDOWS && currentLevel > QUALITY_FULL) {
+      currentLevel = static_cast<QualityLevel>(currentLevel - 1);
+      quietWindows = 0;
+    }
+  } else {
+    quietWindows = 0;
+  }
+  resetWindow();
+}
+
+const char *FrameGovernor::levelName(QualityLevel level) {
+  static const char *const NAMES[QUALITY_COUNT] = {"full", "flat", "coarse",
+                                                   "half-rate", "no-panel"};
+  return level >= 0 && level < QUALITY_COUNT ? NAMES[level] : "unknown";
+}
@@ -0,0 +1,21 @@
+#include "FrameSlot.hpp"
+
+FrameSlot::FrameSlot() : backIndex(0), frontIndex(1), slot(2) {}
+
+bool FrameSlot::publish() {
+  // release：消费者取到编号时一定能看到这一帧的内容
+  uint8_t previous = slot.exchange(static_cast<uint8_t>(backIndex | FRESH),
+                                   std::memory_order_acq_rel);
+  backIndex = previous & ~FRESH;
+  return (previous & FRESH) != 0;
+}
+
+bool FrameSlot::acquire() {
+  if ((slot.load(std::memory_order_relaxed) & FRESH) == 0) {
+    return false;
+  }
+  uint8_t previous = slot.exchange(static_cast<uint8_t>(frontIndex),
+                                   std::memory_order_acq_rel);
+  frontIndex = previous & ~FRESH;
+  return true;
+}
@@ -0,0 +1,131 @@
+#include "FrameStats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+FrameStats::FrameStats() { clear(); }
+
+void FrameStats::clear() {
+  for (int s = 0; s < STAGE_COUNT; s++) {
+    sampleCount[s] = 0;
+    cursor[s] = 0;
+    totalCount[s] = 0;
+    totalMicros[s] = 0;
+    totalMax[s] = 0;
+    std::fill(histogram[s], histogram[s] + BUCKETS, 0);
+  }
+  for (int c = 0; c < COUNTER_COUNT; c++) {
+    pending[c] = 0;
+  }
+  frameCount = 0;
+  frameCursor = 0;
+}
+
+int FrameStats::bucketOf(double micros) {
+  if (micros < 1.0) {
+    return 0;
+  }
+  int exponent;
+  // micros = m·2^e，m ∈ [0.5, 1)
+  double mantissa = std::frexp(micros, &exponent);
+  int sub = static_cast<int>((mantissa * 2 - 1) * SUB_BUCKETS);
+  return std::min(BUCKETS - 1, (exponent - 1) * SUB_BUCKETS + sub);
+}
+
+double FrameStats::bucketUpper(int bucket) {
+  int exponent = bucket / SUB_BUCKETS;
+  int sub = bucket % SUB_BUCKETS;
+  return std::ldexp(1.0 + (sub + 1.0) / SUB_BUCKETS, exponent);
+}
+
+void FrameStats::record(FrameStage stage, double micros) {
+  samples[stage][cursor[stage]] = static_cast<float>(micros);
+  cursor[stage] = (cursor[stage] + 1) % WINDOW;
+  sampleCount[stage] = std::min(WINDOW, sampleCount[stage] + 1);
+
+  histogram[stage][bucketOf(micros)]++;
+  totalCount[stage]++;
+  totalMicros[stage] += micros;
+  totalMax[stage] = std::max(totalMax[stage], micros);
+}
+
+double FrameStats::percentile(FrameStage stage, double fraction) const {
+  int count = sampleCount[stage];
+  if (count == 0) {
+    return 0;
+  }
+  float sorted[WINDOW];
+  std::copy(samples[stage], samples[stage] + count, sorted);
+  int rank = std::min(count - 1, static_cast<int>(fraction * count));
+  std::nth_element(sorted, sorted + rank, sorted + count);
+  return sorted[rank];
+}
+
+double FrameStats::maximum(FrameStage stage) const {
+  int count = sampleCount[stage];
+  return count == 0 ? 0 : *std::max_element(samples[stage],
+                                            samples[stage] + count);
+}
+
+void FrameStats::endFrame(double micros) {
+  for (int c = 0; c < COUNTER_COUNT; c++) {
+    counts[c][frameCursor] = pending[c];
+    pending[c] = 0;
+  }
+  intervals[frameCursor] = static_cast<float>(micros);
+  frameCursor = (frameCursor + 1) % WINDOW;
+  frameCount = std::min(WINDOW, frameCount + 1);
+}
+
+double FrameStats::rate(FrameCounter counter) const {
+  double micros = 0;
+  uint64_t total = 0;
+  for (int i = 0; i < frameCount; i++) {
+    micros += intervals[i];
+    total += counts[counter][i];
+  }
+  return micros > 0 ? total * 1e6 / micros : 0;
+}
+
+uint32_t FrameStats::peakPerFrame(FrameCounter counter) const {
+  return frameCount == 0
+             ? 0
+             : *std::max_element(counts[counter], counts[counter] + frameCount);
+}
+
+const char *FrameStats::stageName(FrameStage stage) {
+  static const char *const NAMES[STAGE_COUNT] = {
+      "animation", "geometry", "sort", "raster", "ui", "refresh", "frame"};
+  return NAMES[stage];
+}
+
+bool FrameStats::writeReport(const std::string &path) const {
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+
+  // 分位数取所在桶的上界，误差不超过 1/8
+  out << "# stage        count     mean_us      p50_us      p99_us"
+         "      max_us\n";
+  out << std::fixed << std::setprecision(1);
+  for (int s = 0; s < STAGE_COUNT; s++) {
+    double p50 = 0, p99 = 0;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS && totalCount[s] > 0; b++) {
+      seen += histogram[s][b];
+      if (p50 == 0 && seen * 2 >= totalCount[s])
+        p50 = bucketUpper(b);
+      if (p99 == 0 && seen * 100 >= totalCount[s] * 99)
+        p99 = bucketUpper(b);
+    }
+    double mean = totalCount[s] ? totalMicros[s] / totalCount[s] : 0;
+    out << std::left << std::setw(10)
+        << stageName(static_cast<FrameStage>(s)) << std::right
+        << std::setw(10) << totalCount[s] << std::setw(12) << mean
+        << std::setw(12) << std::min(p50, totalMax[s]) << std::setw(12)
+        << std::min(p99, totalMax[s]) << std::setw(12) << totalMax[s] << "\n";
+  }
+  return static_cast<bool>(out);
+}
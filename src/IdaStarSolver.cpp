@@ -0,0 +1,250 @@
+#include "IdaStarSolver.hpp"
+#include "CubeSymmetry.hpp"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <unordered_set>
+
+namespace {
+
+// 每展开这么多个节点检查一次取消标志
+constexpr uint64_t CANCEL_INTERVAL = 1 << 16;
+
+// 剩余步数不少于此值的节点才查询、写入置换表：更浅的节点数量多而子树小，
+// 编码和查表的开销超过剪掉的搜索
+constexpr int TABLE_MIN_REMAINING = 5;
+
+// search() 找到解时的返回值
+constexpr int FOUND = -1;
+
+// 搜索被打断时的返回值，大于任何下界
+constexpr int UNBOUNDED = 255;
+
+// 转动序列是否可以省略：同面连转可以合并；对面转动可交换，只保留一种顺序
+// （Face 枚举中对面相邻，face / 2 即对面编号）
+bool redundant(int face, int lastFace) {
+  return lastFace >= 0 &&
+         (face == lastFace || (face / 2 == lastFace / 2 && face < lastFace));
+}
+
+// 置换表的键：状态编码再带上上一步的面（棱块坐标不到39位，放在其上方）。
+// 搜索跳过了与上一步同面的转动，学到的下界只对同样的上一步成立
+StateCode tableKey(const CubeState &state, int lastFace) {
+  StateCode key = state.encode();
+  key.edges |= static_cast<uint64_t>(lastFace + 1) << 39;
+  return key;
+}
+
+// 前两步的一种组合，每轮迭代作为一个任务
+struct Prefix {
+  CubeState state;
+  Move moves[2];
+};
+
+struct CodeHash {
+  size_t operator()(const StateCode &code) const {
+    return static_cast<size_t>(code.hash());
+  }
+};
+
+// 前缀的对称类键：代表元编码，再带上变换到代表元后第三步不能转的面。
+// 键相同的两个前缀互为共轭且搜索约束也对应，剩余的最优步数相同。
+// 代表元自身有对称时，等价的前缀可能得到不同的键，只是少去掉几个重复
+StateCode prefixKey(const Prefix &prefix) {
+  int symmetry = CubeSymmetry::IDENTITY;
+  StateCode key = CubeSymmetry::canonicalCode(prefix.state, &symmetry);
+  uint64_t forbidden = 0;
+  for (int face = FACE_F; face <= FACE_D; face++) {
+    if (redundant(face, prefix.moves[1].face)) {
+      Move turned = CubeSymmetry::conjugateMove(
+          Move(static_cast<Face>(face)), symmetry);
+      forbidden |= 1ULL << turned.face;
+    }
+  }
+  key.edges |= forbidden << 39;
+  return key;
+}
+
+} // namespace
+
+struct IdaStarSolver::Worker {
+  std::vector<Move> path;          ///< 已走的转动
+  uint64_t nodes = 0;              ///< 展开的节点数
+  uint64_t tableHits = 0;          ///< 被置换表剪掉的节点数
+  const std::atomic<bool> *cancel; ///< 调用者的取消标志
+  std::atomic<bool> *stop;         ///< 本轮已找到解或已取消
+};
+
+IdaStarSolver::IdaStarSolver(int threads, size_t tableSlots)
+    : corners(PATTERN_CORNERS), edgesLow(PATTERN_EDGES_LOW),
+      edgesHigh(PATTERN_EDGES_HIGH), pool(threads), table(tableSlots) {}
+
+bool IdaStarSolver::loadTables(const std::string &directory) {
+  bool ok = true;
+  for (PatternDatabase *database : {&corners, &edgesLow, &edgesHigh}) {
+    ok = database->load(directory + "/" +
+                        PatternDatabase::name(database->kind()) + ".pdb") &&
+         ok;
+  }
+  return ok;
+}
+
+bool IdaStarSolver::isReady() const {
+  return corners.isReady() && edgesLow.isReady() && edgesHigh.isReady();
+}
+
+int IdaStarSolver::lowerBound(const CubeState &state) const {
+  return std::max({corners.distance(state), edgesLow.distance(state),
+                   edgesHigh.distance(state)});
+}
+
+bool IdaStarSolver::solve(const CubeState &state, std::vector<Move> &solution,
+                          int maxDepth, const std::atomic<bool> *cancel) {
+  solution.clear();
+  stats = IdaStats();
+  if (!isReady()) {
+    return false;
+  }
+
+  // 互为共轭的前缀只搜第一个：状态有对称（如棋盘格）时任务成倍减少
+  std::vector<Prefix> prefixes;
+  std::unordered_set<StateCode, CodeHash> seen;
+  for (int first = 0; first < Move::COUNT; first++) {
+    Move a = Move::fromIndex(first);
+    CubeState turned = CubeState::multiply(state, CubeState::moveState(a));
+    for (int second = 0; second < Move::COUNT; second++) {
+      Move b = Move::fromIndex(second);
+      if (redundant(b.face, a.face)) {
+        continue;
+      }
+      Prefix prefix{CubeState::multiply(turned, CubeState::moveState(b)),
+                    {a, b}};
+      if (seen.insert(prefixKey(prefix)).second) {
+        prefixes.push_back(prefix);
+      }
+      stats.prefixes++;
+    }
+  }
+  stats.rootTasks = static_cast<int>(prefixes.size());
+
+  // 每轮的上限取上一轮各分支学到的下界中最小的一个（至少加一）
+  stats.startBound = lowerBound(state);
+  std::mutex solutionMutex;
+  for (int bound = stats.startBound; bound <= maxDepth;) {
+    auto begin = std::chrono::steady_clock::now();
+    std::atomic<bool> stop(false);
+    std::atomic<bool> solved(false);
+    std::atomic<uint64_t> nodes(0);
+    std::atomic<uint64_t> tableHits(0);
+    std::atomic<int> next(UNBOUNDED);
+
+    // 汇总一个任务的结果；depth 为任务起点距所求状态的步数
+    auto finish = [&](Worker &worker, int result, int depth) {
+      nodes += worker.nodes;
+      tableHits += worker.tableHits;
+      if (result == FOUND) {
+        std::lock_guard<std::mutex> lock(solutionMutex);
+        if (!solved.exchange(true)) {
+          solution = worker.path;
+        }
+        stop = true;
+        return;
+      }
+      int candidate = result + depth;
+      int current = next.load();
+      while (candidate < current &&
+             !next.compare_exchange_weak(current, candidate)) {
+      }
+    };
+
+    if (bound < 2) {
+      Worker worker{{}, 0, 0, cancel, &stop};
+      finish(worker, search(state, bound, -1, worker), 0);
+    } else {
+      pool.run(prefixes.size(), [&](size_t i) {
+        const Prefix &prefix = prefixes[i];
+        Worker worker{{prefix.moves[0], prefix.moves[1]}, 0, 0, cancel, &stop};
+        finish(worker,
+               search(prefix.state, bound - 2, prefix.moves[1].face, worker),
+               2);
+      });
+    }
+
+    stats.iterations.push_back(IdaIteration{
+        bound, nodes.load(), tableHits.load(),
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - begin)
+            .count()});
+    if (solved) {
+      return true;
+    }
+    if (cancel && cancel->load()) {
+      return false;
+    }
+    bound = std::max(bound + 1, next.load());
+  }
+  return false;
+}
+
+int IdaStarSolver::search(const CubeState &state, int remaining, int lastFace,
+                          Worker &worker) {
+  worker.nodes++;
+  if (worker.stop->load(std::memory_order_relaxed)) {
+    return UNBOUNDED;
+  }
+  if (worker.cancel && worker.nodes % CANCEL_INTERVAL == 0 &&
+      worker.cancel->load()) {
+    worker.stop->store(true);
+    return UNBOUNDED;
+  }
+  if (remaining == 0) {
+    return state.isSolved() ? FOUND : 1;
+  }
+
+  bool useTable = remaining >= TABLE_MIN_REMAINING;
+  StateCode key = {0, 0};
+  if (useTable) {
+    key = tableKey(state, lastFace);
+    TableEntry entry;
+    if (table.probe(key, entry) && entry.value > remaining) {
+      worker.tableHits++;
+      return entry.value;
+    }
+  }
+
+  int best = UNBOUNDED;
+  for (int index = 0; index < Move::COUNT; index++) {
+    Move move = Move::fromIndex(index);
+    if (redundant(move.face, lastFace)) {
+      continue;
+    }
+    // 任一张表的距离 > remaining - 1 即剩下的步数不够，不必再查其余的表
+    CubeState next = CubeState::multiply(state, CubeState::moveState(move));
+    int estimate = corners.distance(next);
+    if (estimate < remaining) {
+      estimate = std::max(estimate, edgesLow.distance(next));
+    }
+    if (estimate < remaining) {
+      estimate = std::max(estimate, edgesHigh.distance(next));
+    }
+    if (estimate >= remaining) {
+      best = std::min(best, estimate + 1);
+      continue;
+    }
+
+    worker.path.push_back(move);
+    int result = search(next, remaining - 1, move.face, worker);
+    if (result == FOUND) {
+      return FOUND;
+    }
+    worker.path.pop_back();
+    best = std::min(best, result + 1);
+  }
+
+  // 被打断时没有搜完所有分支，学到的下界不可信，不写入
+  if (useTable && !worker.stop->load(std::memory_order_relaxed)) {
+    table.store(key, TableEntry{static_cast<uint8_t>(remaining),
+                                static_cast<uint8_t>(best), BOUND_LOWER});
+  }
+  return best;
+}
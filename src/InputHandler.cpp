@@ -0,0 +1,144 @@
+#include "InputHandler.hpp"
+#include "Trace.hpp"
+#include <cstring>
+
+namespace {
+
+// 转动魔方面的按键（小写顺时针，大写逆时针）
+bool isFaceKey(int ch) {
+  return ch > 0 && ch < 128 && std::strchr("fFbBlLrRuUdD", ch) != nullptr;
+}
+
+// 在贴纸上拖动超过这个距离（列，行按两列计）才换算为转动
+constexpr int DRAG_TURN_DISTANCE = 2;
+
+} // namespace
+
+InputHandler::InputHandler(RubiksCube &cube, SolverThread *solver)
+    : cube(cube), solver(solver), dragging(false), prevX(-1), prevY(-1),
+      pendingDx(0), pendingDy(0), dragSticker(0), pressX(-1), pressY(-1) {}
+
+void InputHandler::cancelSolve() {
+  if (solver) {
+    solver->cancel();
+  }
+  cube.clearQueuedMoves();
+}
+
+void InputHandler::applySolverResults() {
+  if (!solver) {
+    return;
+  }
+  SolveResult result;
+  while (solver->poll(result)) {
+    if (result.moves.empty()) {
+      continue; // 已经还原
+    }
+    size_t count = result.kind == SOLVE_HINT ? 1 : result.moves.size();
+    cube.queueMoves(result.moves.data(), count);
+  }
+}
+
+void InputHandler::flush() {
+  if (pendingDx == 0 && pendingDy == 0) {
+    return;
+  }
+  cube.rotateByMouseDelta(static_cast<float>(4 * pendingDx),
+                          static_cast<float>(8 * pendingDy));
+  cube.getFrameStats().count(COUNTER_MOUSE_ROTATIONS);
+  pendingDx = 0;
+  pendingDy = 0;
+}
+
+bool InputHandler::handle(const InputEvent &event) {
+  if (event.type != INPUT_KEY) {
+    TRACE_SCOPE("mouse");
+    if (event.type == INPUT_MOUSE_PRESS) {
+      dragging = true;
+      prevX = pressX = event.x;
+      prevY = pressY = event.y;
+      // 按上一帧的画面拾取，回放时与实际操作看到的画面相同
+      dragSticker = cube.stickerAt(event.x, event.y);
+    } else if (event.type == INPUT_MOUSE_RELEASE) {
+      dragging = false;
+    } else if (dragging && dragSticker != 0) {
+      int dx = event.x - pressX;
+      int dy = event.y - pressY;
+      if (dx * dx + 4 * dy * dy >= DRAG_TURN_DISTANCE * DRAG_TURN_DISTANCE) {
+        Face face;
+        bool clockwise;
+        if (cube.resolveStickerDrag(dragSticker, dx, dy, face, clockwise)) {
+          cancelSolve();
+          cube.turnFace(face, clockwise);
+        }
+        dragging = false; // 本次按下不再响应，直到松开后重新按下
+      }
+    } else if (dragging) {
+      pendingDx += event.x - prevX;
+      pendingDy += event.y - prevY;
+      prevX = event.x;
+      prevY = event.y;
+    }
+    return true;
+  }
+
+  flush();
+  int ch = event.key;
+  if (isFaceKey(ch)) {
+    cancelSolve();
+  }
+  if (ch == INPUT_KEY_ESCAPE || ch == 'q') {
+    return false;
+  } else if (ch == 'c' || ch == 'C') {
+    cancelSolve();
+    cube.reset();
+  } else if (ch == 'x' || ch == 'X') {
+    cancelSolve();
+    cube.scramble(20);
+  } else if (ch == 'h' || ch == 'H' || ch == 's' || ch == 'S') {
+    // 对排队的转动全部播放完之后的状态求解，解接在它们后面播放
+    if (solver) {
+      solver->request(cube.getTargetState(),
+                      ch == 'h' || ch == 'H' ? SOLVE_HINT : SOLVE_FULL);
+    }
+  } else if (ch == 't' || ch == 'T') {
+    cube.toggleStats();
+  } else if (ch == INPUT_KEY_UP) {
+    cube.rotateByMouseDelta(0, -10);
+  } else if (ch == INPUT_KEY_DOWN) {
+    cube.rotateByMouseDelta(0, 10);
+  } else if (ch == INPUT_KEY_LEFT) {
+    cube.rotateByMouseDelta(-10, 0);
+  } else if (ch == INPUT_KEY_RIGHT) {
+    cube.rotateByMouseDelta(10, 0);
+  } else if (ch == '+' || ch == '=') {
+    cube.zoom(1);
+  } else if (ch == '-' || ch == '_') {
+    cube.zoom(-1);
+  } else if (ch == 'f') {
+    cube.rotateViewDirection("F", true);
+  } else if (ch == 'F') {
+    cube.rotateViewDirection("F", false);
+  } else if (ch == 'b') {
+    cube.rotateViewDirection("B", true);
+  } else if (ch == 'B') {
+    cube.rotateViewDirection("B", false);
+  } else if (ch == 'l') {
+    cube.rotateViewDirection("L", true);
+  } else if (ch == 'L') {
+    cube.rotateViewDirection("L", false);
+  } else if (ch == 'r') {
+    cube.rotateViewDirection("R", true);
+  } else if (ch == 'R') {
+    cube.rotateViewDirection("R", false);
+  } else if (ch == 'u') {
+    cube.rotateViewDirection("U", true);
+  } else if (ch == 'U') {
+    cube.rotateViewDirection("U", false);
+  } else if (ch == 'd') {
+    cube.rotateViewDirection("D", true);
+  } else if (ch == 'D') {
+    cube.rotateViewDirection("D", false);
+  }
+  return true;
+}
@@ -0,0 +1,114 @@
+#include "InputLog.hpp"
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+const struct {
+  const char *name;
+  int key;
+} KEY_NAMES[] = {{"esc", INPUT_KEY_ESCAPE},
+                 {"up", INPUT_KEY_UP},
+                 {"down", INPUT_KEY_DOWN},
+                 {"left", INPUT_KEY_LEFT},
+                 {"right", INPUT_KEY_RIGHT}};
+
+const char *const EVENT_NAMES[] = {"key", "press", "release", "move"};
+
+} // namespace
+
+InputLog::InputLog() {}
+
+bool InputLog::load(const std::string &path, std::vector<InputRecord> &records,
+                    uint32_t &seed) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+
+  records.clear();
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::string first;
+    if (!(fields >> first) || first[0] == '#') {
+      continue;
+    }
+    if (first == "seed") {
+      if (!(fields >> seed))
+        return false;
+      continue;
+    }
+
+    InputRecord record{};
+    std::string type;
+    try {
+      record.frame = std::stoull(first);
+    } catch (...) {
+      return false;
+    }
+    if (!(fields >> type)) {
+      return false;
+    }
+
+    if (type == "key") {
+      std::string key;
+      if (!(fields >> key))
+        return false;
+      record.event.type = INPUT_KEY;
+      record.event.key = key.size() == 1 ? key[0] : -1;
+      for (const auto &entry : KEY_NAMES) {
+        if (key == entry.name)
+          record.event.key = entry.key;
+      }
+      if (record.event.key < 0)
+        return false;
+    } else {
+      int typeIndex = -1;
+      for (int i = INPUT_MOUSE_PRESS; i <= INPUT_MOUSE_MOVE; i++) {
+        if (type == EVENT_NAMES[i])
+          typeIndex = i;
+      }
+      if (typeIndex < 0 || !(fields >> record.event.x >> record.event.y))
+        return false;
+      record.event.type = static_cast<InputType>(typeIndex);
+    }
+    records.push_back(record);
+  }
+
+  std::stable_sort(records.begin(), records.end(),
+                   [](const InputRecord &a, const InputRecord &b) {
+                     return a.frame < b.frame;
+                   });
+  return true;
+}
+
+bool InputLog::create(const std::string &path, uint32_t seed) {
+  out.open(path, std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out << "# rubik input log" << std::endl;
+  out << "seed " << seed << std::endl;
+  return true;
+}
+
+void InputLog::append(uint64_t frame, const InputEvent &event) {
+  if (!out.is_open()) {
+    return;
+  }
+
+  out << frame << ' ' << EVENT_NAMES[event.type];
+  if (event.type != INPUT_KEY) {
+    out << ' ' << event.x << ' ' << event.y << '\n';
+    return;
+  }
+
+  for (const auto &entry : KEY_NAMES) {
+    if (event.key == entry.key) {
+      out << ' ' << entry.name << '\n';
+      return;
+    }
+  }
+  out << ' ' << static_cast<char>(event.key) << '\n';
+}
@@ -0,0 +1,57 @@
+#include "Move.hpp"
+#include <sstream>
+
+static const char *const FACE_NAMES[] = {"F", "B", "L", "R", "U", "D"};
+
+// 与 RubiksCube::ROTATION_AXES 保持一致
+static const float FACE_AXES[6][3] = {{0, 0, -1}, {0, 0, 1}, {-1, 0, 0},
+                                      {1, 0, 0},  {0, 1, 0}, {0, -1, 0}};
+
+std::string Move::toString() const {
+  std::string result = FACE_NAMES[face];
+  if (turns == 2) {
+    result += "2";
+  } else if (turns == 3) {
+    result += "'";
+  }
+  return result;
+}
+
+Vector3 Move::faceAxis(Face face) {
+  return Vector3(FACE_AXES[face][0], FACE_AXES[face][1], FACE_AXES[face][2]);
+}
+
+const char *Move::faceName(Face face) { return FACE_NAMES[face]; }
+
+bool Move::faceFromName(const std::string &name, Face &face) {
+  for (int i = 0; i < 6; i++) {
+    if (name == FACE_NAMES[i]) {
+      face = static_cast<Face>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Move::parseSequence(const std::string &text, std::vector<Move> &moves) {
+  std::istringstream iss(text);
+  std::string token;
+  while (iss >> token) {
+    Face face;
+    if (!faceFromName(token.substr(0, 1), face)) {
+      return false;
+    }
+
+    std::string suffix = token.substr(1);
+    if (suffix.empty()) {
+      moves.emplace_back(face, 1);
+    } else if (suffix == "2") {
+      moves.emplace_back(face, 2);
+    } else if (suffix == "'" || suffix == "3") {
+      moves.emplace_back(face, 3);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
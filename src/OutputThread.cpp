@@ -0,0 +1,70 @@
+#include "OutputThread.hpp"
+#include "Trace.hpp"
+
+OutputThread::OutputThread(Renderer &renderer)
+    : renderer(renderer), busy(false), stopping(false), presentedFrames(0),
+      recorder(nullptr), thread(&OutputThread::run, this) {}
+
+OutputThread::~OutputThread() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  thread.join();
+}
+
+void OutputThread::setRecorder(AsciicastRecorder *recorder,
+                               std::chrono::steady_clock::time_point start) {
+  // 加锁保证输出线程之后取到帧时能看到这两个值
+  std::lock_guard<std::mutex> lock(mutex);
+  this->recorder = recorder;
+  recordStart = start;
+}
+
+bool OutputThread::submit() {
+  bool dropped = slot.publish();
+  // 在锁内通知，避免输出线程检查完槽、尚未睡眠时错过唤醒
+  std::lock_guard<std::mutex> lock(mutex);
+  wake.notify_one();
+  return dropped;
+}
+
+void OutputThread::waitIdle() {
+  std::unique_lock<std::mutex> lock(mutex);
+  idle.wait(lock, [this]() { return !busy && !slot.pending(); });
+}
+
+void OutputThread::run() {
+  TRACE_THREAD_NAME("output");
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this]() { return stopping || slot.pending(); });
+      if (stopping) {
+        return;
+      }
+      busy = true;
+    }
+
+    // 输出期间到达的帧在下一次循环中取出，中间被替换的帧就此丢弃
+    while (slot.acquire()) {
+      TRACE_SCOPE("present");
+      renderer.present(slot.front());
+      presentedFrames++;
+      if (recorder) {
+        // 输出之后换给录像，主线程既不复制也不等待
+        recorder->record(slot.front(),
+                         std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - recordStart)
+                             .count());
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      busy = false;
+    }
+    idle.notify_all();
+  }
+}
@@ -0,0 +1,20 @@
+#include "PackedTable.hpp"
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t),
+              "PackedTable::data() requires lock-free 64-bit atomics");
+
+PackedTable::PackedTable(uint64_t entryCount, int bitsPerEntry)
+    : entryCount(entryCount), bitsPerEntry(bitsPerEntry),
+      entriesPerWord(64 / bitsPerEntry),
+      valueMask((1ULL << bitsPerEntry) - 1) {
+  wordTotal = static_cast<size_t>((entryCount + entriesPerWord - 1) /
+                                  entriesPerWord);
+  words.reset(new std::atomic<uint64_t>[wordTotal]);
+  for (size_t i = 0; i < wordTotal; i++) {
+    words[i].store(~0ULL, std::memory_order_relaxed);
+  }
+}
+
+const uint64_t *PackedTable::data() const {
+  return reinterpret_cast<const uint64_t *>(words.get());
+}
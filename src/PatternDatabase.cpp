@@ -0,0 +1,272 @@
+#include "PatternDatabase.hpp"
+
+namespace {
+
+constexpr uint32_t CORNER_PERM_COUNT = 40320; // 8!
+constexpr uint32_t TWIST_COUNT = 2187;        // 3^7
+constexpr uint32_t EDGE_PLACE_COUNT = 665280; // 12!/6!
+constexpr uint32_t FLIP_COUNT = 64;           // 2^6
+constexpr int TRACKED = 6;                    // 棱块子集大小
+constexpr int MOVES = Move::COUNT;
+
+// 编号与 StateCode::corners 一致
+struct CornerTables {
+  uint16_t perm[CORNER_PERM_COUNT][MOVES];
+  uint16_t twist[TWIST_COUNT][MOVES];
+
+  CornerTables() {
+    for (uint32_t p = 0; p < CORNER_PERM_COUNT; p++) {
+      CubeState state;
+      CubeState::unrankPermutation(p, state.cp, 8);
+      for (int m = 0; m < MOVES; m++) {
+        CubeState moved = state;
+        moved.apply(Move::fromIndex(m));
+        perm[p][m] =
+            static_cast<uint16_t>(CubeState::rankPermutation(moved.cp, 8));
+      }
+    }
+
+    for (uint32_t t = 0; t < TWIST_COUNT; t++) {
+      CubeState state;
+      uint32_t rest = t;
+      int sum = 0;
+      for (int i = 6; i >= 0; i--) {
+        state.co[i] = static_cast<uint8_t>(rest % 3);
+        sum += rest % 3;
+        rest /= 3;
+      }
+      state.co[7] = static_cast<uint8_t>((3 - sum % 3) % 3);
+      for (int m = 0; m < MOVES; m++) {
+        CubeState moved = state;
+        moved.apply(Move::fromIndex(m));
+        uint32_t index = 0;
+        for (int i = 0; i < 7; i++) {
+          index = index * 3 + moved.co[i];
+        }
+        twist[t][m] = static_cast<uint16_t>(index);
+      }
+    }
+  }
+
+  uint64_t next(uint64_t index, int m) const {
+    return static_cast<uint64_t>(perm[index / TWIST_COUNT][m]) * TWIST_COUNT +
+           twist[index % TWIST_COUNT][m];
+  }
+};
+
+// 6个被跟踪棱块所在位置的编号（12选6的排列，混合进制）
+uint32_t rankPlaces(const uint8_t *places) {
+  uint32_t rank = 0;
+  for (int k = 0; k < TRACKED; k++) {
+    int digit = places[k];
+    for (int j = 0; j < k; j++) {
+      digit -= places[j] < places[k];
+    }
+    rank = rank * (12 - k) + static_cast<uint32_t>(digit);
+  }
+  return rank;
+}
+
+void unrankPlaces(uint32_t rank, uint8_t *places) {
+  int digits[TRACKED];
+  for (int k = TRACKED - 1; k >= 0; k--) {
+    digits[k] = static_cast<int>(rank % (12 - k));
+    rank /= 12 - k;
+  }
+  bool used[12] = {};
+  for (int k = 0; k < TRACKED; k++) {
+    int position = 0;
+    for (int skip = digits[k];; position++) {
+      if (!used[position] && skip-- == 0)
+        break;
+    }
+    used[position] = true;
+    places[k] = static_cast<uint8_t>(position);
+  }
+}
+
+// 每项低20位为转动后的位置编号，高6位为各跟踪棱块的翻转变化
+struct EdgeTables {
+  std::unique_ptr<uint32_t[]> places;
+
+  EdgeTables() : places(new uint32_t[EDGE_PLACE_COUNT * MOVES]) {
+    // 单个棱块在每种转动下的去向与翻转
+    uint8_t target[MOVES][12];
+    uint8_t flip[MOVES][12];
+    for (int m = 0; m < MOVES; m++) {
+      const CubeState &move = CubeState::moveState(Move::fromIndex(m));
+      for (int q = 0; q < 12; q++) {
+        target[m][move.ep[q]] = static_cast<uint8_t>(q);
+        flip[m][move.ep[q]] = move.eo[q];
+      }
+    }
+
+    for (uint32_t p = 0; p < EDGE_PLACE_COUNT; p++) {
+      uint8_t current[TRACKED];
+      unrankPlaces(p, current);
+      for (int m = 0; m < MOVES; m++) {
+        uint8_t moved[TRACKED];
+        uint32_t flips = 0;
+        for (int k = 0; k < TRACKED; k++) {
+          moved[k] = target[m][current[k]];
+          flips |= static_cast<uint32_t>(flip[m][current[k]]) << k;
+        }
+        places[p * MOVES + m] = rankPlaces(moved) | flips << 20;
+      }
+    }
+  }
+
+  uint64_t next(uint64_t index, int m) const {
+    uint32_t entry = places[index / FLIP_COUNT * MOVES + m];
+    return static_cast<uint64_t>(entry & 0xFFFFF) * FLIP_COUNT +
+           ((index % FLIP_COUNT) ^ (entry >> 20));
+  }
+};
+
+const CornerTables &cornerTables() {
+  static const CornerTables instance;
+  return instance;
+}
+
+const EdgeTables &edgeTables() {
+  static const EdgeTables instance;
+  return instance;
+}
+
+} // namespace
+
+PatternDatabase::PatternDatabase(PatternKind kind, int bitsPerEntry)
+    : patternKind(kind), bits(bitsPerEntry), words(nullptr) {}
+
+uint64_t PatternDatabase::entryCount(PatternKind kind) {
+  return kind == PATTERN_CORNERS
+             ? static_cast<uint64_t>(CORNER_PERM_COUNT) * TWIST_COUNT
+             : static_cast<uint64_t>(EDGE_PLACE_COUNT) * FLIP_COUNT;
+}
+
+const char *PatternDatabase::name(PatternKind kind) {
+  switch (kind) {
+  case PATTERN_CORNERS:
+    return "corners";
+  case PATTERN_EDGES_LOW:
+    return "edges-low";
+  case PATTERN_EDGES_HIGH:
+    return "edges-high";
+  default:
+    return "unknown";
+  }
+}
+
+size_t PatternDatabase::tableBytes() const {
+  uint64_t perWord = 64 / bits;
+  return static_cast<size_t>((entryCount(patternKind) + perWord - 1) /
+                             perWord * sizeof(uint64_t));
+}
+
+BuildStats PatternDatabase::generate(int threads) {
+  auto table = std::make_unique<PackedTable>(entryCount(patternKind), bits);
+
+  BuildStats stats;
+  if (patternKind == PATTERN_CORNERS) {
+    const CornerTables &tables = cornerTables();
+    stats = TableBuilder::build(
+        *table, 0,
+        [&tables](uint64_t index, auto &&visit) {
+          for (int m = 0; m < MOVES; m++) {
+            if (visit(tables.next(index, m)))
+              return;
+          }
+        },
+        threads);
+  } else {
+    // 两个棱块子集共用同一张转移表，只是还原状态的编号不同
+    const EdgeTables &tables = edgeTables();
+    uint8_t solved[TRACKED];
+    for (int k = 0; k < TRACKED; k++) {
+      solved[k] = static_cast<uint8_t>(
+          patternKind == PATTERN_EDGES_LOW ? k : k + TRACKED);
+    }
+    uint64_t start = static_cast<uint64_t>(rankPlaces(solved)) * FLIP_COUNT;
+    stats = TableBuilder::build(
+        *table, start,
+        [&tables](uint64_t index, auto &&visit) {
+          for (int m = 0; m < MOVES; m++) {
+            if (visit(tables.next(index, m)))
+              return;
+          }
+        },
+        threads);
+  }
+
+  mapped.close();
+  generated = std::move(table);
+  words = generated->data();
+  return stats;
+}
+
+bool PatternDatabase::save(const std::string &path) const {
+  if (!words) {
+    return false;
+  }
+  return TableFile::write(path, name(patternKind), bits,
+                          entryCount(patternKind), words,
+                          tableBytes() / sizeof(uint64_t));
+}
+
+bool PatternDatabase::load(const std::string &path) {
+  if (!mapped.open(path, name(patternKind), bits, entryCount(patternKind))) {
+    return false;
+  }
+  generated.reset();
+  words = mapped.words();
+  return true;
+}
+
+uint64_t PatternDatabase::indexOf(const CubeState &state) const {
+  if (patternKind == PATTERN_CORNERS) {
+    uint32_t twist = 0;
+    for (int i = 0; i < 7; i++) {
+      twist = twist * 3 + state.co[i];
+    }
+    return static_cast<uint64_t>(CubeState::rankPermutation(state.cp, 8)) *
+               TWIST_COUNT +
+           twist;
+  }
+
+  int first = patternKind == PATTERN_EDGES_LOW ? 0 : TRACKED;
+  uint8_t places[TRACKED];
+  uint32_t flips = 0;
+  for (int q = 0; q < 12; q++) {
+    int k = state.ep[q] - first;
+    if (k >= 0 && k < TRACKED) {
+      places[k] = static_cast<uint8_t>(q);
+      flips |= static_cast<uint32_t>(state.eo[q]) << k;
+    }
+  }
+  return static_cast<uint64_t>(rankPlaces(places)) * FLIP_COUNT + flips;
+}
+
+int PatternDatabase::distance(const CubeState &state) const {
+  if (!words || bits != 4) {
+    return -1;
+  }
+  return valueAt(indexOf(state));
+}
+
+int PatternDatabase::distance(const CubeState &state,
+                              int parentDistance) const {
+  if (!words) {
+    return -1;
+  }
+  int value = valueAt(indexOf(state));
+  if (bits == 4) {
+    return value;
+  }
+  // 子状态距离只可能是 parent-1、parent、parent+1，模3各不相同
+  for (int d = parentDistance - 1; d <= parentDistance + 1; d++) {
+    if (d >= 0 && d % 3 == value) {
+      return d;
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,83 @@
+#include "PieceTransform.hpp"
+#include "RotationGroup.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 每种面转动对每个位置的作用：目标位置和施加的旋转（不在该层的位置保持不动）
+struct MoveTable {
+  uint8_t nextSlot[Move::COUNT][PieceTransform::SLOT_COUNT];
+  uint8_t rotation[Move::COUNT][PieceTransform::SLOT_COUNT];
+
+  MoveTable() {
+    for (int m = 0; m < Move::COUNT; m++) {
+      Move move = Move::fromIndex(m);
+      Face face = static_cast<Face>(move.face);
+      Vector3 axis = Move::faceAxis(face);
+      int turn = RotationGroup::faceTurn(face, move.turns);
+
+      for (int slot = 0; slot < PieceTransform::SLOT_COUNT; slot++) {
+        Vector3 position = PieceTransform::slotPosition(slot);
+        if (position.dot(axis) > 0.5f) {
+          nextSlot[m][slot] = static_cast<uint8_t>(PieceTransform::slotIndex(
+              RotationGroup::apply(turn, position)));
+          rotation[m][slot] = static_cast<uint8_t>(turn);
+        } else {
+          nextSlot[m][slot] = static_cast<uint8_t>(slot);
+          rotation[m][slot] = RotationGroup::IDENTITY;
+        }
+      }
+    }
+  }
+};
+
+const MoveTable &moveTable() {
+  static const MoveTable instance;
+  return instance;
+}
+
+int roundCoordinate(float value) {
+  return std::max(-1, std::min(1, static_cast<int>(std::lround(value))));
+}
+
+} // namespace
+
+PieceTransform::PieceTransform() {
+  for (int slot = 0; slot < SLOT_COUNT; slot++) {
+    target[slot] = static_cast<uint8_t>(slot);
+    turn[slot] = RotationGroup::IDENTITY;
+  }
+}
+
+void PieceTransform::apply(const Move &move) {
+  const MoveTable &table = moveTable();
+  const RotationGroup::ProductTable &product = RotationGroup::productTable();
+  const int m = move.index();
+
+  for (int slot = 0; slot < SLOT_COUNT; slot++) {
+    int current = target[slot];
+    target[slot] = table.nextSlot[m][current];
+    turn[slot] = product[table.rotation[m][current]][turn[slot]];
+  }
+}
+
+PieceTransform PieceTransform::fromMoves(const Move *moves, size_t count) {
+  PieceTransform transform;
+  for (size_t i = 0; i < count; i++) {
+    transform.apply(moves[i]);
+  }
+  return transform;
+}
+
+int PieceTransform::slotIndex(const Vector3 &position) {
+  return (roundCoordinate(position.x) + 1) * 9 +
+         (roundCoordinate(position.y) + 1) * 3 +
+         (roundCoordinate(position.z) + 1);
+}
+
+Vector3 PieceTransform::slotPosition(int slot) {
+  return Vector3(static_cast<float>(slot / 9 - 1),
+                 static_cast<float>(slot / 3 % 3 - 1),
+                 static_cast<float>(slot % 3 - 1));
+}
@@ -0,0 +1,181 @@
+#include "RotationGroup.hpp"
+#include "Move.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float HALF_PI = 3.14159265359f / 2.0f;
+
+struct Matrix {
+  int m[3][3];
+
+  bool operator==(const Matrix &other) const {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        if (m[i][j] != other.m[i][j])
+          return false;
+      }
+    }
+    return true;
+  }
+};
+
+// 将四元数分量吸附到 {0, ±1/2, ±√2/2, ±1}，消除三角函数带来的误差
+float snapComponent(float value) {
+  static const float CANDIDATES[] = {0.0f, 0.5f, 0.70710678f, 1.0f};
+  float magnitude = std::abs(value);
+  float best = 0.0f;
+  for (float candidate : CANDIDATES) {
+    if (std::abs(magnitude - candidate) < std::abs(magnitude - best)) {
+      best = candidate;
+    }
+  }
+  return value < 0 ? -best : best;
+}
+
+Quaternion snap(const Quaternion &q) {
+  Quaternion result(snapComponent(q.w), snapComponent(q.x), snapComponent(q.y),
+                    snapComponent(q.z));
+  // q 与 -q 表示同一旋转，统一取第一个非零分量为正
+  float components[] = {result.w, result.x, result.y, result.z};
+  for (float c : components) {
+    if (c != 0.0f) {
+      if (c < 0.0f) {
+        result = Quaternion(-result.w, -result.x, -result.y, -result.z);
+      }
+      break;
+    }
+  }
+  return result;
+}
+
+Matrix toMatrix(const Quaternion &q) {
+  Matrix result;
+  const Vector3 basis[] = {Vector3(1, 0, 0), Vector3(0, 1, 0),
+                           Vector3(0, 0, 1)};
+  for (int col = 0; col < 3; col++) {
+    Vector3 v = q.rotateVector(basis[col]);
+    result.m[0][col] = static_cast<int>(std::lround(v.x));
+    result.m[1][col] = static_cast<int>(std::lround(v.y));
+    result.m[2][col] = static_cast<int>(std::lround(v.z));
+  }
+  return result;
+}
+
+Matrix multiply(const Matrix &a, const Matrix &b) {
+  Matrix result;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      result.m[i][j] = 0;
+      for (int k = 0; k < 3; k++) {
+        result.m[i][j] += a.m[i][k] * b.m[k][j];
+      }
+    }
+  }
+  return result;
+}
+
+struct Tables {
+  std::vector<Matrix> matrices;
+  std::vector<Quaternion> quaternions;
+  RotationGroup::ProductTable product;
+  std::array<uint8_t, RotationGroup::SIZE> inverse;
+  std::array<std::array<uint8_t, 4>, 6> faceTurns;
+
+  int find(const Matrix &matrix) const {
+    for (size_t i = 0; i < matrices.size(); i++) {
+      if (matrices[i] == matrix)
+        return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  Tables() {
+    // 从绕 x、y、z 轴的90度旋转生成整个群（广度优先闭包）
+    matrices.push_back(toMatrix(Quaternion(1, 0, 0, 0)));
+    quaternions.push_back(Quaternion(1, 0, 0, 0));
+
+    const Quaternion generators[] = {
+        snap(Quaternion::fromAxisAngle(Vector3(1, 0, 0), HALF_PI)),
+        snap(Quaternion::fromAxisAngle(Vector3(0, 1, 0), HALF_PI)),
+        snap(Quaternion::fromAxisAngle(Vector3(0, 0, 1), HALF_PI))};
+
+    for (size_t i = 0; i < quaternions.size(); i++) {
+      for (const auto &generator : generators) {
+        Quaternion q = snap(generator.multiply(quaternions[i]));
+        Matrix matrix = toMatrix(q);
+        if (find(matrix) < 0) {
+          matrices.push_back(matrix);
+          quaternions.push_back(q);
+        }
+      }
+    }
+
+    for (int a = 0; a < RotationGroup::SIZE; a++) {
+      for (int b = 0; b < RotationGroup::SIZE; b++) {
+        int ab = find(multiply(matrices[a], matrices[b]));
+        product[a][b] = static_cast<uint8_t>(ab);
+        if (ab == RotationGroup::IDENTITY) {
+          inverse[a] = static_cast<uint8_t>(b);
+        }
+      }
+    }
+
+    for (int face = 0; face < 6; face++) {
+      Vector3 axis = Move::faceAxis(static_cast<Face>(face));
+      for (int turns = 0; turns < 4; turns++) {
+        Quaternion q = snap(Quaternion::fromAxisAngle(axis, turns * HALF_PI));
+        faceTurns[face][turns] = static_cast<uint8_t>(find(toMatrix(q)));
+      }
+    }
+  }
+};
+
+const Tables &tables() {
+  static const Tables instance;
+  return instance;
+}
+
+} // namespace
+
+const RotationGroup::ProductTable &RotationGroup::productTable() {
+  return tables().product;
+}
+
+int RotationGroup::inverse(int r) { return tables().inverse[r]; }
+
+Vector3 RotationGroup::apply(int r, const Vector3 &vec) {
+  const auto &m = tables().matrices[r].m;
+  return Vector3(m[0][0] * vec.x + m[0][1] * vec.y + m[0][2] * vec.z,
+                 m[1][0] * vec.x + m[1][1] * vec.y + m[1][2] * vec.z,
+                 m[2][0] * vec.x + m[2][1] * vec.y + m[2][2] * vec.z);
+}
+
+const Quaternion &RotationGroup::quaternion(int r) {
+  return tables().quaternions[r];
+}
+
+int RotationGroup::fromQuaternion(const Quaternion &q) {
+  const auto &quaternions = tables().quaternions;
+  int best = IDENTITY;
+  float bestDot = -1.0f;
+  for (int r = 0; r < SIZE; r++) {
+    const Quaternion &candidate = quaternions[r];
+    float dot = std::abs(q.w * candidate.w + q.x * candidate.x +
+                         q.y * candidate.y + q.z * candidate.z);
+    if (dot > bestDot) {
+      bestDot = dot;
+      best = r;
+    }
+  }
+  return best;
+}
+
+int RotationGroup::faceTurn(Face face, int turns) {
+  return tables().faceTurns[face][((turns % 4) + 4) % 4];
+}
+
+int RotationGroup::matrix(int r, int row, int col) {
+  return tables().matrices[r].m[row][col];
+}
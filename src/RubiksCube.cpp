@@ -1,7 +1,12 @@
 #include "RubiksCube.hpp"
 #include "Enums.hpp"
+#include "PieceTransform.hpp"
+#include "RotationGroup.hpp"
+#include "Trace.hpp"
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <functional>
 #include <random>
 
@@ -37,19 +42,17 @@ const std::map<std::string, Vector3> RubiksCube::ROTATION_AXES = {
 RubiksCube::RubiksCube()
     : rotation(1, 0, 0, 0), scale(25.0f), position(0, 0, 10), aspectRatio(2.0f),
       cameraPosition(0, 0, 0), focalLength(8.0f), animating(false),
-      animationProgress(0.0f) {
+      animationTicks(0), animationProgress(0.0f), previousProgress(0.0f),
+      accumulator(0), interpolation(0.0f), random(std::random_device()()),
+      showStats(false), showUI(true), uiPanelScale(0), uiPanelAnimating(false),
+      uiPanelValid(false), uiPanelX(-1), uiPanelY(0), pickWidth(0),
+      pickHeight(0) {
 
   // Initialize light direction
   lightDir = Vector3(0.3f, 0.5f, -0.8f).normalized();
 
-  // Initialize view directions
-  viewDirections = {{"F", Vector3(0, 0, -1)}, {"B", Vector3(0, 0, 1)},
-                    {"L", Vector3(-1, 0, 0)}, {"R", Vector3(1, 0, 0)},
-                    {"U", Vector3(0, 1, 0)},  {"D", Vector3(0, -1, 0)}};
-
   // Initialize view mapping
-  viewMapping = {{"F", "F"}, {"B", "B"}, {"L", "L"},
-                 {"R", "R"}, {"U", "U"}, {"D", "D"}};
+  updateViewMapping();
 
   createPieces();
 }
@@ -102,48 +105,118 @@ void RubiksCube::createPieces() {
   }
 }
 
-void RubiksCube::updateViewMapping() {
-  for (const auto &[viewDirName, viewDir] : viewDirections) {
-    std::string bestFace;
-    float bestDot = -1.0f;
+namespace {
+
+// 块上贴纸的面名称，下标就是贴纸编号中的面序号
+const std::vector<std::string> FACE_NAMES = {"F", "B", "L", "R", "U", "D"};
+
+/**
+ * @brief 向负无穷取整的整数除法
+ * @param a 被除数
+ * @param b 除数（必须为正）
+ * @return floor(a / b)
+ */
+long long floorDiv(long long a, long long b) {
+  long long q = a / b;
+  return (a % b != 0 && a < 0) ? q - 1 : q;
+}
+
+/**
+ * @struct EdgeWalker
+ * @brief 沿多边形的一条边逐行推进的 x 坐标（整数 DDA）
+ */
+struct EdgeWalker {
+  int x;         ///< 当前行的 x
+  int step;      ///< 每行 x 的整数增量
+  int remainder; ///< 每行增量的余数部分（0 <= remainder < dy）
+  int error;     ///< 累计余数
+  int dy;        ///< 边的高度
+  int endY;      ///< 边的结束行（不含）
+
+  /**
+   * @brief 从指定行开始沿边 from -> to 推进
+   * @param from 边的起点
+   * @param to 边的终点
+   * @param y 开始行
+   */
+  void start(const std::pair<int, int> &from, const std::pair<int, int> &to,
+             int y) {
+    endY = to.second;
+    dy = to.second - from.second;
+    if (dy <= 0) {
+      // 水平边不覆盖任何行，直接转到下一条边
+      x = to.first;
+      step = remainder = error = 0;
+      return;
+    }
+
+    // x = from.x + floor((y - from.y) * dx / dy)，逐行累加余数避免浮点
+    int dx = to.first - from.first;
+    step = static_cast<int>(floorDiv(dx, dy));
+    remainder = dx - step * dy;
+    long long numerator = static_cast<long long>(y - from.second) * dx;
+    long long offset = floorDiv(numerator, dy);
+    x = from.first + static_cast<int>(offset);
+    error = static_cast<int>(numerator - offset * dy);
+  }
 
-    Quaternion invRotation(rotation.w, -rotation.x, -rotation.y, -rotation.z);
-    Vector3 dirInCubeSpace = invRotation.rotateVector(viewDir);
+  /**
+   * @brief 推进到下一行
+   */
+  void next() {
+    x += step;
+    error += remainder;
+    if (error >= dy) {
+      x++;
+      error -= dy;
+    }
+  }
+};
 
-    static const std::map<std::string, Vector3> FACE_NORMALS = {
-        {"F", Vector3(0, 0, -1)}, {"B", Vector3(0, 0, 1)},
-        {"L", Vector3(-1, 0, 0)}, {"R", Vector3(1, 0, 0)},
-        {"U", Vector3(0, 1, 0)},  {"D", Vector3(0, -1, 0)}};
+} // namespace
 
-    for (const auto &[faceName, faceNormalVec] : FACE_NORMALS) {
-      float dot = dirInCubeSpace.dot(faceNormalVec);
-      if (dot > bestDot) {
+void RubiksCube::updateViewMapping() {
+  // 魔方三个坐标轴在世界坐标系中的方向
+  const Vector3 axes[3] = {rotation.rotateVector(Vector3(1, 0, 0)),
+                           rotation.rotateVector(Vector3(0, 1, 0)),
+                           rotation.rotateVector(Vector3(0, 0, 1))};
+  // 各坐标轴正、负方向对应的面
+  static const Face AXIS_FACES[3][2] = {
+      {FACE_R, FACE_L}, {FACE_U, FACE_D}, {FACE_B, FACE_F}};
+
+  for (Face view : {FACE_F, FACE_L, FACE_U}) {
+    Vector3 direction = Move::faceAxis(view);
+    int bestAxis = 0;
+    float bestDot = 0.0f;
+    for (int i = 0; i < 3; i++) {
+      float dot = direction.dot(axes[i]);
+      if (std::abs(dot) > std::abs(bestDot)) {
         bestDot = dot;
-        bestFace = faceName;
+        bestAxis = i;
       }
     }
 
-    if (!bestFace.empty() && bestDot > 0.5f) {
-      viewMapping[viewDirName] = bestFace;
-    }
+    // Face 中相对的两个面编号只差最低位
+    Face face = AXIS_FACES[bestAxis][bestDot > 0 ? 0 : 1];
+    viewFaces[view] = face;
+    viewFaces[view ^ 1] = static_cast<Face>(face ^ 1);
   }
+  viewMappingDirty = false;
 }
 
 void RubiksCube::rotateByMouseDelta(float dx, float dy) {
-  float rotateSpeed = 0.01f;
-  if (dx != 0) {
-    Quaternion rotY =
-        Quaternion::fromAxisAngle(Vector3(0, 1, 0), -dx * rotateSpeed);
-    rotation = rotY.multiply(rotation).normalize();
-    updateViewMapping();
-  }
+  TRACE_SCOPE("rotateByMouseDelta");
+  if (dx == 0 && dy == 0)
+    return;
 
-  if (dy != 0) {
-    Quaternion rotX =
-        Quaternion::fromAxisAngle(Vector3(1, 0, 0), -dy * rotateSpeed);
-    rotation = rotX.multiply(rotation).normalize();
-    updateViewMapping();
-  }
+  // 先绕 Y 轴再绕 X 轴，合成一次旋转后只归一化和更新映射一次
+  float rotateSpeed = 0.01f;
+  Quaternion rotY =
+      Quaternion::fromAxisAngle(Vector3(0, 1, 0), -dx * rotateSpeed);
+  Quaternion rotX =
+      Quaternion::fromAxisAngle(Vector3(1, 0, 0), -dy * rotateSpeed);
+  rotation = rotX.multiply(rotY).multiply(rotation).normalize();
+  viewMappingDirty = true;
 }
 
 void RubiksCube::zoom(float factor) {
@@ -152,17 +225,23 @@ void RubiksCube::zoom(float factor) {
 
 void RubiksCube::rotateViewDirection(const std::string &viewDirection,
                                      bool clockwise) {
-  auto it = viewMapping.find(viewDirection);
-  if (it == viewMapping.end()) {
+  TRACE_SCOPE("rotateViewDirection");
+  Face view;
+  if (!Move::faceFromName(viewDirection, view)) {
     return;
   }
 
-  std::string actualFace = it->second;
+  turnFace(viewFace(view), clockwise);
+}
+
+void RubiksCube::turnFace(Face face, bool clockwise) {
+  std::string actualFace = Move::faceName(face);
   completeAnimation();
 
   animating = true;
+  animationTicks = 0;
   animationProgress = 0.0f;
-  animationStartTime = std::chrono::steady_clock::now();
+  previousProgress = 0.0f;
 
   auto axesIt = ROTATION_AXES.find(actualFace);
   if (axesIt == ROTATION_AXES.end()) {
@@ -176,20 +255,38 @@ void RubiksCube::rotateViewDirection(const std::string &viewDirection,
       axis, clockwise ? ROTATION_ANGLE : -ROTATION_ANGLE);
 }
 
-void RubiksCube::updateAnimation() {
+void RubiksCube::update(std::chrono::nanoseconds elapsed) {
+  ScopedTimer timer(frameStats, STAGE_ANIMATION);
+  TRACE_SCOPE("update");
+
+  constexpr std::chrono::nanoseconds tick(1000000000 / TICK_RATE);
+  accumulator = std::min(accumulator + elapsed, MAX_CATCH_UP);
+  while (accumulator >= tick) {
+    step();
+    accumulator -= tick;
+  }
+  interpolation = static_cast<float>(accumulator.count()) / tick.count();
+}
+
+void RubiksCube::step() {
+  previousProgress = animationProgress;
+  if (!animating && !moveQueue.empty()) {
+    Move move = moveQueue.front();
+    moveQueue.pop_front();
+    turnFace(static_cast<Face>(move.face), move.turns == 1);
+  }
   if (!animating)
     return;
 
-  auto now = std::chrono::steady_clock::now();
-  auto elapsed = std::chrono::duration<float>(now - animationStartTime).count();
-  animationProgress = std::min(1.0f, elapsed / ANIMATION_DURATION);
-
-  if (animationProgress >= 1.0f) {
+  animationTicks++;
+  animationProgress = static_cast<float>(animationTicks) / ANIMATION_TICKS;
+  if (animationTicks >= ANIMATION_TICKS) {
     completeAnimation();
   }
 }
 
 void RubiksCube::completeAnimation() {
+  TRACE_SCOPE("completeAnimation");
   if (!std::get<1>(currentAnimation).empty() && !animationPieces.empty()) {
     auto [axis, actualFace, clockwise] = currentAnimation;
     float angle = clockwise ? ROTATION_ANGLE : -ROTATION_ANGLE;
@@ -200,7 +297,9 @@ void RubiksCube::completeAnimation() {
   }
 
   animating = false;
+  animationTicks = 0;
   animationProgress = 0.0f;
+  previousProgress = 0.0f;
   currentAnimation = std::make_tuple(Vector3(), "", false);
   animationPieces.clear();
   animationRotation = Quaternion(1, 0, 0, 0);
@@ -254,7 +353,7 @@ Vector3 RubiksCube::getPiecePosition(
                              piece) != animationPieces.end()) {
     auto [axis, _, clockwise] = currentAnimation;
     float partialAngle =
-        (clockwise ? ROTATION_ANGLE : -ROTATION_ANGLE) * animationProgress;
+        (clockwise ? ROTATION_ANGLE : -ROTATION_ANGLE) * displayedProgress();
     Quaternion partialRotation = Quaternion::fromAxisAngle(axis, partialAngle);
     return partialRotation.rotateVector(piece->getCurrentPosition());
   }
@@ -269,32 +368,29 @@ Color RubiksCube::getPieceFaceColor(
   return piece->getCurrentFaceColor(faceName);
 }
 
-std::vector<Vector3>
-RubiksCube::getPieceFaceCorners(const std::shared_ptr<RubiksCubePiece> &piece,
-                                const std::string &faceName) const {
-  auto corners = piece->getFaceCorners(faceName);
+int RubiksCube::getPieceFaceCorners(
+    const std::shared_ptr<RubiksCubePiece> &piece, const std::string &faceName,
+    Vector3 *corners) const {
+  int count = piece->getFaceCorners(faceName, corners);
 
   if (animating && std::find(animationPieces.begin(), animationPieces.end(),
                              piece) != animationPieces.end()) {
     auto [axis, _, clockwise] = currentAnimation;
     float partialAngle =
-        (clockwise ? ROTATION_ANGLE : -ROTATION_ANGLE) * animationProgress;
+        (clockwise ? ROTATION_ANGLE : -ROTATION_ANGLE) * displayedProgress();
     Quaternion partialRotation = Quaternion::fromAxisAngle(axis, partialAngle);
 
-    std::vector<Vector3> rotatedCorners;
-    for (const auto &corner : corners) {
-      rotatedCorners.push_back(partialRotation.rotateVector(corner));
+    for (int i = 0; i < count; i++) {
+      corners[i] = partialRotation.rotateVector(corners[i]);
     }
-    corners = rotatedCorners;
   }
 
   Vector3 piecePos = getPiecePosition(piece);
-  std::vector<Vector3> worldCorners;
-  for (const auto &corner : corners) {
-    worldCorners.push_back(corner + piecePos);
+  for (int i = 0; i < count; i++) {
+    corners[i] = corners[i] + piecePos;
   }
 
-  return worldCorners;
+  return count;
 }
 
 float RubiksCube::calculateBrightness(const Vector3 &normal) const {
@@ -331,116 +427,118 @@ RubiksCube::projectPoint(const Vector3 &point, int width, int height) const {
   return std::make_tuple(screenXInt, screenYInt, relativePoint.length());
 }
 
-void RubiksCube::drawPolygon(WINDOW *win,
-                             const std::vector<std::pair<int, int>> &points,
-                             int colorPair, char colorChar) {
-  if (points.size() < 3)
+void RubiksCube::drawPolygon(CellBuffer &buffer,
+                             const std::pair<int, int> *points, int count,
+                             int color, char colorChar, uint8_t sticker,
+                             int cellSize) {
+  if (count < 3)
     return;
+  TRACE_SCOPE("drawPolygon");
+
+  // 找到最高点和最低点
+  int top = 0;
+  int bottom = 0;
+  for (int i = 1; i < count; i++) {
+    if (points[i].second < points[top].second)
+      top = i;
+    if (points[i].second > points[bottom].second)
+      bottom = i;
+  }
 
-  // Get window dimensions
-  int maxY, maxX;
-  getmaxyx(win, maxY, maxX);
-
-  // 简单填充算法：扫描线填充
-  if (points.size() >= 3) {
-    // 找到多边形的y范围
-    int minY = maxY, maxYVal = 0;
-    for (const auto &p : points) {
-      if (p.second < minY)
-        minY = p.second;
-      if (p.second > maxYVal)
-        maxYVal = p.second;
+  // 限制在窗口范围内（以格块为单位，最后一块可以只有一半在画面内）
+  int startY = std::max(0, points[top].second);
+  int endY = std::min((buffer.height() + cellSize - 1) / cellSize,
+                      points[bottom].second);
+
+  // 两条边链都从最高点出发，一条按顶点顺序、一条逆序，直到最低点
+  EdgeWalker left, right;
+  int leftIndex = top;
+  int rightIndex = top;
+  left.endY = right.endY = points[top].second;
+  for (int y = startY; y < endY; y++) {
+    while (y >= left.endY) {
+      int next = (leftIndex + count - 1) % count;
+      left.start(points[leftIndex], points[next], y);
+      leftIndex = next;
+    }
+    while (y >= right.endY) {
+      int next = (rightIndex + 1) % count;
+      right.start(points[rightIndex], points[next], y);
+      rightIndex = next;
     }
 
-    // 限制在窗口范围内
-    minY = std::max(0, minY);
-    maxYVal = std::min(maxY - 1, maxYVal);
-
-    // 对每条扫描线计算交点
-    for (int y = minY; y <= maxYVal; y++) {
-      std::vector<int> intersections;
-
-      for (size_t i = 0; i < points.size(); i++) {
-        size_t j = (i + 1) % points.size();
-        int y1 = points[i].second;
-        int y2 = points[j].second;
-        int x1 = points[i].first;
-        int x2 = points[j].first;
-
-        if ((y1 <= y && y2 > y) || (y2 <= y && y1 > y)) {
-          // 计算交点
-          float t = static_cast<float>(y - y1) / (y2 - y1);
-          int intersectX = static_cast<int>(x1 + t * (x2 - x1));
-          intersections.push_back(intersectX);
-        }
-      }
-
-      // 排序交点
-      std::sort(intersections.begin(), intersections.end());
-
-      // 填充扫描线
-      for (size_t i = 0; i < intersections.size(); i += 2) {
-        if (i + 1 >= intersections.size())
-          break;
-
-        int startX = std::max(0, intersections[i]);
-        int endX = std::min(maxX - 1, intersections[i + 1]);
-
-        for (int x = startX; x <= endX; x++) {
-          if (y >= 0 && y < maxY && x >= 0 && x < maxX) {
-            if (colorPair > 0) {
-              wattron(win, COLOR_PAIR(colorPair));
-              mvwaddch(win, y, x, colorChar);
-              wattroff(win, COLOR_PAIR(colorPair));
-            } else {
-              mvwaddch(win, y, x, colorChar);
-            }
-          }
-        }
-      }
+    int x0 = std::min(left.x, right.x) * cellSize;
+    int x1 = std::max(left.x, right.x) * cellSize + cellSize - 1;
+    for (int row = y * cellSize;
+         row < std::min(buffer.height(), (y + 1) * cellSize); row++) {
+      fillSpan(buffer, row, x0, x1, color, colorChar, sticker);
     }
+    left.next();
+    right.next();
   }
 }
 
-void RubiksCube::draw(WINDOW *win, int width, int height,
-                      std::map<int, int> &colorCache) {
-  werase(win);
-  updateAnimation();
+void RubiksCube::draw(CellBuffer &buffer) {
+  int width = buffer.width();
+  int height = buffer.height();
+  buffer.clear();
+  frameArena.reset();
+  pickWidth = width;
+  pickHeight = height;
+  pickBuffer.assign(static_cast<size_t>(width) * height, 0);
+
+  QualityLevel quality = governor.level();
+  int cellSize = quality >= QUALITY_COARSE ? 2 : 1;
+
+  // 光栅化要跳过控制面板，所以先确定面板位置；这部分耗时计入 UI 阶段。
+  // 隐藏面板时仍留出它的位置，魔方不画进去，画面不比上一档多
+  auto panelStart = std::chrono::steady_clock::now();
+  if (showUI && (quality < QUALITY_NO_PANEL || !uiPanelValid)) {
+    updateUIPanel(width, height);
+  } else if (showUI) {
+    placeUIPanel(width, height);
+  } else {
+    uiPanelX = -1;
+  }
+  auto panelTime = std::chrono::steady_clock::now() - panelStart;
 
   // 定义要绘制的面片数据结构
   struct FaceData {
-    std::vector<std::pair<int, int>> points; // 屏幕上的多边形顶点
-    int colorPair;                           // ncurses 颜色对编号
-    float depth;                             // 深度（用于排序）
-    char colorChar;                          // 填充字符
+    std::pair<int, int> points[MAX_POLYGON_POINTS]; // 屏幕上的多边形顶点
+    int pointCount;                                 // 顶点数
+    int color;                                      // 终端256色索引
+    float depth;                                    // 深度（用于排序）
+    char colorChar;                                 // 填充字符
+    uint8_t sticker;                                // 贴纸编号
   };
 
-  std::vector<FaceData> facesToDraw;
-
-  static const std::vector<std::string> FACE_NAMES = {"F", "B", "L",
-                                                      "R", "U", "D"};
+  // 每块最多6个面，临时数据都从本帧的 arena 分配
+  FaceData *facesToDraw = frameArena.allocateArray<FaceData>(pieces.size() * 6);
+  size_t faceCount = 0;
 
-  for (const auto &piece : pieces) {
-    // 获取块的当前位置（考虑动画）
-    Vector3 piecePos = getPiecePosition(piece);
-
-    for (const auto &faceName : FACE_NAMES) {
+  auto geometryStart = std::chrono::steady_clock::now();
+  TRACE_BEGIN("projection");
+  for (size_t p = 0; p < pieces.size(); p++) {
+    const auto &piece = pieces[p];
+    for (size_t f = 0; f < FACE_NAMES.size(); f++) {
+      const std::string &faceName = FACE_NAMES[f];
       // 获取该面在块上的颜色（直接查表，不依赖旋转）
       Color colorIdx = piece->getCurrentFaceColor(faceName);
       if (colorIdx == _COLOR_NONE)
         continue;
 
       // 获取该面在世界坐标系中的角点
-      auto corners = getPieceFaceCorners(piece, faceName);
-      if (corners.size() < 3)
+      Vector3 corners[MAX_POLYGON_POINTS];
+      int cornerCount = getPieceFaceCorners(piece, faceName, corners);
+      if (cornerCount < 3)
         continue;
 
       // 计算面中心（用于深度排序）
       Vector3 center(0, 0, 0);
-      for (const auto &corner : corners) {
-        center = center + corner;
+      for (int i = 0; i < cornerCount; i++) {
+        center = center + corners[i];
       }
-      center = center * (1.0f / corners.size());
+      center = center * (1.0f / cornerCount);
 
       // 将中心旋转到世界坐标系（考虑魔方整体旋转）
       Vector3 rotatedCenter = rotation.rotateVector(center);
@@ -458,158 +556,383 @@ void RubiksCube::draw(WINDOW *win, int width, int height,
         continue; // 背面，跳过
       }
 
-      // 计算亮度
-      float brightness = calculateBrightness(normalWorld);
-
-      // 获取基础颜色并应用亮度
       int colorIndexInt = static_cast<int>(colorIdx);
       if (colorIndexInt < 0 ||
           colorIndexInt >= static_cast<int>(COLOR_RGB.size())) {
         continue; // 防御性检查
       }
-      RGB baseColor = COLOR_RGB[colorIndexInt];
-      RGB shadedColor = baseColor.applyBrightness(brightness);
-
-      // 转换为终端256色索引并初始化颜色对
-      int terminalColorIndex = shadedColor.to256Color();
-      int colorPair;
-      auto it = colorCache.find(terminalColorIndex);
-      if (it != colorCache.end()) {
-        colorPair = it->second;
+
+      // 按光照计算亮度并转换为终端256色索引；平面着色时直接用基础颜色
+      int terminalColorIndex;
+      if (quality >= QUALITY_FLAT) {
+        terminalColorIndex = COLOR_RGB[colorIndexInt].to256Color();
       } else {
-        colorPair = static_cast<int>(colorCache.size()) + 1;
-        init_pair(colorPair, terminalColorIndex, COLOR_BLACK);
-        colorCache[terminalColorIndex] = colorPair;
+        float brightness = calculateBrightness(normalWorld);
+        RGB shadedColor = COLOR_RGB[colorIndexInt].applyBrightness(brightness);
+        terminalColorIndex = shadedColor.to256Color();
       }
 
-      // 将3D角点投影到2D屏幕
-      std::vector<std::pair<int, int>> screenPoints;
-      for (const auto &corner3d : corners) {
-        auto [x, y, _] = projectPoint(corner3d, width, height);
-        screenPoints.emplace_back(x, y);
+      // 将3D角点投影到2D屏幕；半分辨率时换算成 2x2 格块的坐标
+      FaceData &face = facesToDraw[faceCount];
+      face.pointCount = cornerCount;
+      for (int i = 0; i < face.pointCount; i++) {
+        auto [x, y, _] = projectPoint(corners[i], width, height);
+        if (cellSize == 2) {
+          // 向下取整，负数同样适用
+          x = (x - (x & 1)) / 2;
+          y = (y - (y & 1)) / 2;
+        }
+        face.points[i] = {x, y};
       }
 
       // 获取显示字符
       if (colorIndexInt >= 0 &&
           colorIndexInt < static_cast<int>(COLOR_CHARS.size())) {
-        char colorChar = COLOR_CHARS[colorIndexInt];
-        float depth = (worldCenter - cameraPosition).length();
-        facesToDraw.push_back({screenPoints, colorPair, depth, colorChar});
+        face.color = terminalColorIndex;
+        face.depth = (worldCenter - cameraPosition).length();
+        face.colorChar = COLOR_CHARS[colorIndexInt];
+        face.sticker = static_cast<uint8_t>(p * FACE_NAMES.size() + f + 1);
+        faceCount++;
       }
     }
   }
 
+  TRACE_END("projection");
+  frameStats.record(STAGE_GEOMETRY,
+                    std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - geometryStart)
+                        .count());
+
   // 按深度从远到近排序（画家算法）
-  std::sort(
-      facesToDraw.begin(), facesToDraw.end(),
-      [](const FaceData &a, const FaceData &b) { return a.depth > b.depth; });
+  {
+    ScopedTimer timer(frameStats, STAGE_SORT);
+    TRACE_SCOPE("sort");
+    std::sort(
+        facesToDraw, facesToDraw + faceCount,
+        [](const FaceData &a, const FaceData &b) { return a.depth > b.depth; });
+  }
 
   // 绘制所有面
-  for (const auto &face : facesToDraw) {
-    drawPolygon(win, face.points, face.colorPair, face.colorChar);
+  {
+    ScopedTimer timer(frameStats, STAGE_RASTER);
+    TRACE_SCOPE("raster");
+    for (size_t i = 0; i < faceCount; i++) {
+      const FaceData &face = facesToDraw[i];
+      drawPolygon(buffer, face.points, face.pointCount, face.color,
+                  face.colorChar, face.sticker, cellSize);
+    }
   }
 
   // 绘制UI
-  drawUI(win, width, height);
+  {
+    TRACE_SCOPE("drawUI");
+    auto uiStart = std::chrono::steady_clock::now();
+    if (showUI) {
+      drawUI(buffer, width, height);
+    }
+    frameStats.record(STAGE_UI,
+                      std::chrono::duration<double, std::micro>(
+                          panelTime + std::chrono::steady_clock::now() -
+                          uiStart)
+                          .count());
+  }
 }
 
-void RubiksCube::drawUI(WINDOW *win, int width, int height) {
-  std::string title = "3x3 Rubik's Cube";
-  if (width >= static_cast<int>(title.length())) {
-    mvwprintw(win, 0, (width - title.length()) / 2, "%s", title.c_str());
+void RubiksCube::fillSpan(CellBuffer &buffer, int y, int x0, int x1,
+                          int color, char colorChar, uint8_t sticker) {
+  // 颜色和贴纸编号写同一段格子；drawPolygon 已保证 y 在画面内
+  auto fill = [&](int from, int to) {
+    buffer.fill(y, from, to, colorChar, color);
+    from = std::max(0, from);
+    to = std::min(pickWidth - 1, to);
+    if (from <= to) {
+      auto row = pickBuffer.begin() + static_cast<size_t>(y) * pickWidth;
+      std::fill(row + from, row + to + 1, sticker);
+    }
+  };
+
+  if (uiPanelX >= 0 && y >= uiPanelY && y < uiPanelY + uiPanel.height()) {
+    // 面板所在行只填充面板左右两侧
+    fill(x0, std::min(x1, uiPanelX - 1));
+    fill(std::max(x0, uiPanelX + uiPanel.width()), x1);
+    return;
   }
+  fill(x0, x1);
+}
 
-  updateViewMapping();
+int RubiksCube::stickerAt(int x, int y) const {
+  if (x < 0 || y < 0 || x >= pickWidth || y >= pickHeight) {
+    return 0;
+  }
+  return pickBuffer[static_cast<size_t>(y) * pickWidth + x];
+}
 
-  // 安全地获取颜色名称
-  auto getColorName = [this](const std::string &face) -> std::string {
-    try {
-      auto viewIt = viewMapping.find(face);
-      if (viewIt != viewMapping.end()) {
-        auto colorIt = FACE_TO_COLOR.find(viewIt->second);
-        if (colorIt != FACE_TO_COLOR.end()) {
-          int colorIndex = static_cast<int>(colorIt->second);
-          if (colorIndex >= 0 &&
-              colorIndex < static_cast<int>(COLOR_NAMES.size())) {
-            return COLOR_NAMES[colorIndex];
-          }
-        }
-      }
-    } catch (...) {
-      // 忽略异常
+bool RubiksCube::resolveStickerDrag(int sticker, int dx, int dy, Face &face,
+                                    bool &clockwise) const {
+  int faceCount = static_cast<int>(FACE_NAMES.size());
+  if (sticker <= 0 || sticker > static_cast<int>(pieces.size()) * faceCount ||
+      (dx == 0 && dy == 0)) {
+    return false;
+  }
+  const auto &piece = pieces[(sticker - 1) / faceCount];
+  Vector3 corners[MAX_POLYGON_POINTS];
+  int count =
+      piece->getFaceCorners(FACE_NAMES[(sticker - 1) % faceCount], corners);
+  if (count < 3) {
+    return false;
+  }
+
+  // 贴纸中心相对块中心的偏移沿贴纸法线方向
+  Vector3 offset(0, 0, 0);
+  for (int i = 0; i < count; i++) {
+    offset = offset + corners[i];
+  }
+  offset = offset * (1.0f / count);
+  Vector3 position = piece->getCurrentPosition();
+  Vector3 center = position + offset;
+
+  // 比较方向时把行高换算成列宽
+  float dragX = static_cast<float>(dx);
+  float dragY = static_cast<float>(dy) * aspectRatio;
+  float dragLength = std::sqrt(dragX * dragX + dragY * dragY);
+
+  static const Vector3 AXES[3] = {Vector3(1, 0, 0), Vector3(0, 1, 0),
+                                  Vector3(0, 0, 1)};
+  auto [centerX, centerY, centerDepth] =
+      projectPoint(center, pickWidth, pickHeight);
+  int bestAxis = -1;
+  float bestCos = 0.0f;
+  for (int i = 0; i < 3; i++) {
+    if (std::abs(offset.dot(AXES[i])) > 0.25f) {
+      continue; // 法线方向
     }
-    return "Unknown";
-  };
+    // 绕该轴正向转动时贴纸中心的速度为 axis x center
+    Vector3 moved = center + AXES[i].cross(center) * 0.5f;
+    auto [movedX, movedY, movedDepth] =
+        projectPoint(moved, pickWidth, pickHeight);
+    float motionX = static_cast<float>(movedX - centerX);
+    float motionY = static_cast<float>(movedY - centerY) * aspectRatio;
+    float motionLength = std::sqrt(motionX * motionX + motionY * motionY);
+    if (motionLength == 0.0f) {
+      continue;
+    }
+    float cosine =
+        (motionX * dragX + motionY * dragY) / (motionLength * dragLength);
+    if (std::abs(cosine) > std::abs(bestCos)) {
+      bestCos = cosine;
+      bestAxis = i;
+    }
+  }
+  if (bestAxis < 0) {
+    return false;
+  }
 
-  std::vector<std::string> controls = {
-      "Controls:",
-      "  Arrow Keys - Rotate cube",
-      "  +/-        - Zoom in/out",
-      "  C          - Reset cube",
-      "  X          - Scramble cube",
-      "  ESC        - Exit",
-      "",
-      "Rotate faces (based on current view):",
-      "  f - Front clockwise  F - Front counter",
-      "  b - Back clockwise   B - Back counter",
-      "  l - Left clockwise   L - Left counter",
-      "  r - Right clockwise  R - Right counter",
-      "  u - Up clockwise     U - Up counter",
-      "  d - Down clockwise   D - Down counter",
-      "",
-      "Current view mapping:",
-      "  Front(F) -> " + getColorName("F") + " face",
-      "  Back(B)  -> " + getColorName("B") + " face",
-      "  Left(L)  -> " + getColorName("L") + " face",
-      "  Right(R) -> " + getColorName("R") + " face",
-      "  Up(U)    -> " + getColorName("U") + " face",
-      "  Down(D)  -> " + getColorName("D") + " face",
-      "",
-      "Scale: " + std::to_string(static_cast<int>(scale)),
-      "Animation: " + std::string(animating ? "Active" : "None")};
-
-  int boxWidth = 0;
-  for (const auto &line : controls) {
-    boxWidth = std::max(boxWidth, static_cast<int>(line.length()));
-  }
-  boxWidth += 4;
-
-  int boxHeight = static_cast<int>(controls.size()) + 2;
-  int boxX = width - boxWidth - 2;
-  int boxY = 2;
+  float layer = position.dot(AXES[bestAxis]);
+  if (std::abs(layer) < 0.5f) {
+    return false; // 中层
+  }
+  // 各坐标轴负、正两侧的层对应的面；面的转轴（ROTATION_AXES）指向层所在
+  // 的一侧，顺时针即绕转轴正向转动
+  static const char *const LAYER_FACES[3][2] = {
+      {"L", "R"}, {"D", "U"}, {"F", "B"}};
+  if (!Move::faceFromName(LAYER_FACES[bestAxis][layer > 0 ? 1 : 0], face)) {
+    return false;
+  }
+  clockwise = (bestCos > 0) == (layer > 0);
+  return true;
+}
 
-  if (boxX > 0 && boxY > 0 && boxX + boxWidth < width &&
-      boxY + boxHeight < height) {
-    // Draw box border
-    mvwaddch(win, boxY, boxX, '+');
-    mvwaddch(win, boxY, boxX + boxWidth - 1, '+');
-    mvwaddch(win, boxY + boxHeight - 1, boxX, '+');
-    mvwaddch(win, boxY + boxHeight - 1, boxX + boxWidth - 1, '+');
-
-    for (int x = boxX + 1; x < boxX + boxWidth - 1; x++) {
-      mvwaddch(win, boxY, x, '-');
-      mvwaddch(win, boxY + boxHeight - 1, x, '-');
+void RubiksCube::updateUIPanel(int width, int height) {
+  int panelScale = static_cast<int>(scale);
+  bool changed = !uiPanelValid || uiPanelScale != panelScale ||
+                 uiPanelAnimating != animating;
+  for (int i = 0; i < 6; i++) {
+    changed = changed || uiPanelFaces[i] != viewFace(static_cast<Face>(i));
+  }
+
+  if (changed) {
+    TRACE_SCOPE("uiPanel");
+    for (int i = 0; i < 6; i++) {
+      uiPanelFaces[i] = viewFace(static_cast<Face>(i));
+    }
+    uiPanelScale = panelScale;
+    uiPanelAnimating = animating;
+    uiPanelValid = true;
+
+    // 安全地获取颜色名称
+    auto getColorName = [this](Face view) -> const char * {
+      auto colorIt = FACE_TO_COLOR.find(Move::faceName(uiPanelFaces[view]));
+      if (colorIt != FACE_TO_COLOR.end()) {
+        int colorIndex = static_cast<int>(colorIt->second);
+        if (colorIndex >= 0 &&
+            colorIndex < static_cast<int>(COLOR_NAMES.size())) {
+          return COLOR_NAMES[colorIndex].c_str();
+        }
+      }
+      return "Unknown";
+    };
+
+    // 可变的行格式化到栈上的缓冲区，重绘面板不做堆分配
+    static const char *const VIEW_LABELS[6] = {
+        "Front(F)", "Back(B) ", "Left(L) ", "Right(R)", "Up(U)   ", "Down(D) "};
+    char viewLines[6][48];
+    for (int i = 0; i < 6; i++) {
+      std::snprintf(viewLines[i], sizeof(viewLines[i]), "  %s -> %s face",
+                    VIEW_LABELS[i], getColorName(static_cast<Face>(i)));
+    }
+    char scaleLine[32];
+    std::snprintf(scaleLine, sizeof(scaleLine), "Scale: %d", panelScale);
+
+    const char *const controls[] = {
+        "Controls:",
+        "  Arrow Keys - Rotate cube",
+        "  +/-        - Zoom in/out",
+        "  C          - Reset cube",
+        "  X          - Scramble cube",
+        "  T          - Toggle timing panel",
+        "  H          - Hint (play next move)",
+        "  S          - Solve automatically",
+        "  ESC        - Exit",
+        "",
+        "Rotate faces (based on current view):",
+        "  f - Front clockwise  F - Front counter",
+        "  b - Back clockwise   B - Back counter",
+        "  l - Left clockwise   L - Left counter",
+        "  r - Right clockwise  R - Right counter",
+        "  u - Up clockwise     U - Up counter",
+        "  d - Down clockwise   D - Down counter",
+        "",
+        "Current view mapping:",
+        viewLines[FACE_F],
+        viewLines[FACE_B],
+        viewLines[FACE_L],
+        viewLines[FACE_R],
+        viewLines[FACE_U],
+        viewLines[FACE_D],
+        "",
+        scaleLine,
+        animating ? "Animation: Active" : "Animation: None"};
+    const int lineCount = static_cast<int>(sizeof(controls) / sizeof(*controls));
+
+    int boxWidth = 0;
+    for (const char *line : controls) {
+      boxWidth = std::max(boxWidth, static_cast<int>(std::strlen(line)));
     }
+    boxWidth += 4;
+    int boxHeight = lineCount + 2;
+    uiPanel.resize(boxWidth, boxHeight);
 
-    for (int y = boxY + 1; y < boxY + boxHeight - 1; y++) {
-      mvwaddch(win, y, boxX, '|');
-      mvwaddch(win, y, boxX + boxWidth - 1, '|');
+    // Draw box border
+    uiPanel.set(0, 0, '+');
+    uiPanel.set(boxWidth - 1, 0, '+');
+    uiPanel.set(0, boxHeight - 1, '+');
+    uiPanel.set(boxWidth - 1, boxHeight - 1, '+');
+    uiPanel.fill(0, 1, boxWidth - 2, '-');
+    uiPanel.fill(boxHeight - 1, 1, boxWidth - 2, '-');
+    for (int y = 1; y < boxHeight - 1; y++) {
+      uiPanel.set(0, y, '|');
+      uiPanel.set(boxWidth - 1, y, '|');
     }
 
     // Draw text
-    for (size_t i = 0; i < controls.size(); i++) {
-      mvwprintw(win, boxY + 1 + static_cast<int>(i), boxX + 2, "%s",
-                controls[i].c_str());
+    for (int i = 0; i < lineCount; i++) {
+      uiPanel.text(2, 1 + i, controls[i]);
     }
   }
+  placeUIPanel(width, height);
+}
+
+void RubiksCube::placeUIPanel(int width, int height) {
+  int boxX = width - uiPanel.width() - 2;
+  int boxY = 2;
+  bool fits = boxX > 0 && boxX + uiPanel.width() < width &&
+              boxY + uiPanel.height() < height;
+  uiPanelX = fits ? boxX : -1;
+  uiPanelY = boxY;
+}
+
+void RubiksCube::drawUI(CellBuffer &buffer, int width, int height) {
+  static const std::string title = "3x3 Rubik's Cube";
+  if (width >= static_cast<int>(title.length())) {
+    buffer.text((width - static_cast<int>(title.length())) / 2, 0, title);
+  }
 
-  std::string footer = "Press ESC to exit | C to reset | X to scramble";
+  if (uiPanelX >= 0 && governor.level() < QUALITY_NO_PANEL) {
+    buffer.blit(uiPanel, uiPanelX, uiPanelY);
+  }
+
+  if (showStats) {
+    drawStatsPanel(buffer, std::max(0, width - uiPanel.width() - 3),
+                   uiPanelY);
+  }
+
+  if (governor.isAdaptive()) {
+    drawGovernorStatus(buffer, 1, height - 2);
+  }
+
+  static const std::string footer = "Press ESC to exit | C to reset | X to scramble";
   if (width >= static_cast<int>(footer.length())) {
-    wattron(win, A_REVERSE);
-    mvwprintw(win, height - 1, (width - footer.length()) / 2, "%s",
-              footer.c_str());
-    wattroff(win, A_REVERSE);
+    buffer.text((width - static_cast<int>(footer.length())) / 2, height - 1,
+                footer, CellBuffer::ATTR_REVERSE);
+  }
+}
+
+void RubiksCube::drawStatsPanel(CellBuffer &buffer, int right, int top) {
+  // 最近 FrameStats::WINDOW 帧的滚动统计，单位毫秒
+  const int panelWidth = 38;
+  int left = right - panelWidth;
+  if (left < 0) {
+    return;
   }
+
+  char line[64];
+  const char *border = "+------------------------------------+";
+  buffer.text(left, top, border);
+  std::snprintf(line, sizeof(line), "| %-12s %6s %6s %7s |", "Timing (ms)",
+                "p50", "p99", "max");
+  buffer.text(left, top + 1, line);
+  for (int s = 0; s < STAGE_COUNT; s++) {
+    FrameStage stage = static_cast<FrameStage>(s);
+    std::snprintf(line, sizeof(line), "| %-12s %6.2f %6.2f %7.2f |",
+                  FrameStats::stageName(stage),
+                  frameStats.percentile(stage, 0.5) / 1000.0,
+                  frameStats.percentile(stage, 0.99) / 1000.0,
+                  frameStats.maximum(stage) / 1000.0);
+    buffer.text(left, top + 2 + s, line);
+  }
+
+  // 输入事件、实际旋转和丢弃帧的速率，以及单帧的最大个数
+  static const char *const COUNTER_NAMES[COUNTER_COUNT] = {
+      "input events", "rotations", "dropped"};
+  for (int c = 0; c < COUNTER_COUNT; c++) {
+    FrameCounter counter = static_cast<FrameCounter>(c);
+    std::snprintf(line, sizeof(line), "| %-12s %7.0f/s   max %5u |",
+                  COUNTER_NAMES[c], frameStats.rate(counter),
+                  frameStats.peakPerFrame(counter));
+    buffer.text(left, top + 2 + STAGE_COUNT + c, line);
+  }
+  buffer.text(left, top + 2 + STAGE_COUNT + COUNTER_COUNT, border);
+}
+
+void RubiksCube::drawGovernorStatus(CellBuffer &buffer, int x, int y) {
+  // 最近各帧耗时占预算的比例，超预算的帧显示为 '!'
+  static const char LEVELS[] = " .:-=+*#";
+  char graph[FrameGovernor::HISTORY + 1];
+  int count = governor.historySize();
+  for (int i = 0; i < count; i++) {
+    double ratio = governor.historyAt(i) / governor.budget();
+    int shade = std::min(7, static_cast<int>(ratio * 8));
+    graph[i] = ratio > 1.0 ? '!' : LEVELS[shade];
+  }
+  graph[count] = '\0';
+
+  char line[96];
+  QualityLevel level = governor.level();
+  std::snprintf(line, sizeof(line), "Quality %d/%d %-9s [%-*s] %.1f ms",
+                static_cast<int>(level), QUALITY_COUNT - 1,
+                FrameGovernor::levelName(level), FrameGovernor::HISTORY,
+                graph, governor.budget() / 1000.0);
+  buffer.text(x, y, line);
 }
 
 void RubiksCube::reset() {
@@ -621,50 +944,181 @@ void RubiksCube::reset() {
   scale = 25.0f;
   position = Vector3(0, 0, 10);
   animating = false;
+  animationTicks = 0;
   animationProgress = 0.0f;
+  previousProgress = 0.0f;
   currentAnimation = std::make_tuple(Vector3(), "", false);
   animationPieces.clear();
   animationRotation = Quaternion(1, 0, 0, 0);
+  moveQueue.clear();
 
-  viewMapping = {{"F", "F"}, {"B", "B"}, {"L", "L"},
-                 {"R", "R"}, {"U", "U"}, {"D", "D"}};
+  updateViewMapping();
 }
 
 void RubiksCube::scramble(int moves) {
-  std::vector<std::string> viewDirections = {"F", "B", "L", "R", "U", "D"};
-
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dirDist(
-      0, static_cast<int>(viewDirections.size()) - 1);
+  std::uniform_int_distribution<> dirDist(0, 5);
   std::uniform_int_distribution<> boolDist(0, 1);
 
+  std::vector<Move> sequence;
+  sequence.reserve(std::max(0, moves));
+
   for (int i = 0; i < moves; i++) {
-    std::string viewDir = viewDirections[dirDist(gen)];
-    bool clockwise = boolDist(gen) == 0;
+    Face view = static_cast<Face>(dirDist(random));
+    bool clockwise = boolDist(random) == 0;
+    sequence.emplace_back(viewFace(view), clockwise ? 1 : 3);
+  }
 
-    auto it = viewMapping.find(viewDir);
-    if (it == viewMapping.end())
-      continue;
+  applyMoves(sequence);
+}
+
+void RubiksCube::applyMoves(const Move *moves, size_t count) {
+  // 先结算进行中的动画，保证块姿态处于整90度状态
+  completeAnimation();
 
-    std::string actualFace = it->second;
-    auto piecesToRotate = getPiecesOnFace(actualFace);
+  PieceTransform transform = PieceTransform::fromMoves(moves, count);
 
-    auto axesIt = ROTATION_AXES.find(actualFace);
-    if (axesIt == ROTATION_AXES.end())
-      continue;
+  for (auto &piece : pieces) {
+    int slot = PieceTransform::slotIndex(piece->getCurrentPosition());
+    int current = RotationGroup::fromQuaternion(piece->getLocalRotation());
+    int next = RotationGroup::multiply(transform.turnAt(slot), current);
 
-    Vector3 axis = axesIt->second;
-    float angle = clockwise ? ROTATION_ANGLE : -ROTATION_ANGLE;
+    // 直接写入精确姿态，同时消除逐步旋转累积的浮点误差
+    piece->setState(RotationGroup::apply(next, piece->getInitialPosition()),
+                    RotationGroup::quaternion(next));
+  }
+}
 
-    for (auto &piece : piecesToRotate) {
-      piece->rotate(axis, angle);
+void RubiksCube::queueMoves(const Move *moves, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    Face face = static_cast<Face>(moves[i].face);
+    if (moves[i].turns == 2) {
+      moveQueue.emplace_back(face, 1);
+      moveQueue.emplace_back(face, 1);
+    } else if (moves[i].turns != 0) {
+      moveQueue.push_back(moves[i]);
+    }
+  }
+}
+
+void RubiksCube::applyMoves(const std::vector<Move> &moves) {
+  applyMoves(moves.data(), moves.size());
+}
+
+CubeState RubiksCube::getState() const {
+  CubeState state;
+
+  for (const auto &piece : pieces) {
+    PieceType type = piece->getPieceType();
+    if (type == PIECE_CENTER)
+      continue;
+
+    int turn = RotationGroup::fromQuaternion(piece->getLocalRotation());
+    Vector3 home = piece->getInitialPosition();
+    Vector3 current = RotationGroup::apply(turn, home);
+
+    if (type == PIECE_CORNER) {
+      int from = 0, to = 0;
+      for (int i = 0; i < 8; i++) {
+        if (CubeState::cornerPosition(i) == home)
+          from = i;
+        if (CubeState::cornerPosition(i) == current)
+          to = i;
+      }
+      Vector3 reference = RotationGroup::apply(
+          turn, Move::faceAxis(CubeState::CORNER_FACES[from][0]));
+      state.cp[to] = static_cast<uint8_t>(from);
+      for (int k = 0; k < 3; k++) {
+        if (Move::faceAxis(CubeState::CORNER_FACES[to][k]) == reference)
+          state.co[to] = static_cast<uint8_t>(k);
+      }
+    } else {
+      int from = 0, to = 0;
+      for (int i = 0; i < 12; i++) {
+        if (CubeState::edgePosition(i) == home)
+          from = i;
+        if (CubeState::edgePosition(i) == current)
+          to = i;
+      }
+      Vector3 reference = RotationGroup::apply(
+          turn, Move::faceAxis(CubeState::EDGE_FACES[from][0]));
+      state.ep[to] = static_cast<uint8_t>(from);
+      state.eo[to] =
+          Move::faceAxis(CubeState::EDGE_FACES[to][0]) == reference ? 0 : 1;
     }
   }
 
+  return state;
+}
+
+void RubiksCube::setState(const CubeState &state) {
   animating = false;
+  animationTicks = 0;
   animationProgress = 0.0f;
+  previousProgress = 0.0f;
   currentAnimation = std::make_tuple(Vector3(), "", false);
   animationPieces.clear();
   animationRotation = Quaternion(1, 0, 0, 0);
+  moveQueue.clear();
+
+  for (auto &piece : pieces) {
+    Vector3 home = piece->getInitialPosition();
+    Vector3 target = home;
+    Vector3 reference, targetReference;
+
+    if (piece->getPieceType() == PIECE_CORNER) {
+      int from = 0;
+      for (int i = 0; i < 8; i++) {
+        if (CubeState::cornerPosition(i) == home)
+          from = i;
+      }
+      for (int j = 0; j < 8; j++) {
+        if (state.cp[j] != from)
+          continue;
+        target = CubeState::cornerPosition(j);
+        reference = Move::faceAxis(CubeState::CORNER_FACES[from][0]);
+        targetReference =
+            Move::faceAxis(CubeState::CORNER_FACES[j][state.co[j]]);
+      }
+    } else if (piece->getPieceType() == PIECE_EDGE) {
+      int from = 0;
+      for (int i = 0; i < 12; i++) {
+        if (CubeState::edgePosition(i) == home)
+          from = i;
+      }
+      for (int j = 0; j < 12; j++) {
+        if (state.ep[j] != from)
+          continue;
+        target = CubeState::edgePosition(j);
+        reference = Move::faceAxis(CubeState::EDGE_FACES[from][0]);
+        targetReference =
+            Move::faceAxis(CubeState::EDGE_FACES[j][state.eo[j]]);
+      }
+    }
+
+    // 中心块不计入状态，回到初始姿态（贴纸颜色不受影响）
+    int turn = RotationGroup::IDENTITY;
+    if (piece->getPieceType() != PIECE_CENTER) {
+      for (int r = 0; r < RotationGroup::SIZE; r++) {
+        if (RotationGroup::apply(r, home) == target &&
+            RotationGroup::apply(r, reference) == targetReference) {
+          turn = r;
+          break;
+        }
+      }
+    }
+    piece->setState(RotationGroup::apply(turn, home),
+                    RotationGroup::quaternion(turn));
+  }
+}
+
+CubeState RubiksCube::getTargetState() const {
+  CubeState state = getState();
+  Face face;
+  if (animating && Move::faceFromName(std::get<1>(currentAnimation), face)) {
+    state.apply(Move(face, std::get<2>(currentAnimation) ? 1 : 3));
+  }
+  for (const Move &move : moveQueue) {
+    state.apply(move);
+  }
+  return state;
 }
@@ -59,8 +59,14 @@ void RubiksCubePiece::rotate(const Vector3 &axis, float angle) {
   localRotation = rotation.multiply(localRotation).normalize();
 }
 
-std::vector<Vector3>
-RubiksCubePiece::getFaceCorners(const std::string &faceName) const {
+void RubiksCubePiece::setState(const Vector3 &position,
+                               const Quaternion &rotation) {
+  currentPosition = position;
+  localRotation = rotation;
+}
+
+int RubiksCubePiece::getFaceCorners(const std::string &faceName,
+                                    Vector3 *corners) const {
   static const std::map<std::string,
                         std::vector<std::tuple<float, float, float>>>
       FACE_CORNERS = {{"F",
@@ -96,18 +102,17 @@ RubiksCubePiece::getFaceCorners(const std::string &faceName) const {
 
   auto it = FACE_CORNERS.find(faceName);
   if (it == FACE_CORNERS.end()) {
-    return {};
+    return 0;
   }
 
-  std::vector<Vector3> corners;
+  int count = 0;
   for (const auto &corner : it->second) {
     Vector3 cornerVec(std::get<0>(corner), std::get<1>(corner),
                       std::get<2>(corner));
-    Vector3 rotatedCorner = localRotation.rotateVector(cornerVec);
-    corners.push_back(rotatedCorner);
+    corners[count++] = localRotation.rotateVector(cornerVec);
   }
 
-  return corners;
+  return count;
 }
 
 Color RubiksCubePiece::getCurrentFaceColor(const std::string &faceName) const {
@@ -0,0 +1,99 @@
+#include "SolverThread.hpp"
+#include "Trace.hpp"
+#include <chrono>
+
+SolverThread::SolverThread(SolverMode mode, size_t memoryLimit, int maxDepth)
+    : mode(mode), optimal(memoryLimit, maxDepth), generation(0), working(false),
+      stopping(false), cancelFlag(false), thread(&SolverThread::run, this) {}
+
+SolverThread::~SolverThread() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    cancelFlag = true;
+  }
+  wake.notify_one();
+  thread.join();
+}
+
+void SolverThread::request(const CubeState &state, SolveKind kind) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    generation++;
+    cancelFlag = working;
+    jobs.clear();
+    results.clear();
+    jobs.push_back(Job{state, kind, generation});
+  }
+  wake.notify_one();
+}
+
+void SolverThread::cancel() {
+  std::lock_guard<std::mutex> lock(mutex);
+  generation++;
+  cancelFlag = working;
+  jobs.clear();
+  results.clear();
+}
+
+bool SolverThread::poll(SolveResult &result) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (results.empty()) {
+    return false;
+  }
+  result = std::move(results.front());
+  results.pop_front();
+  return true;
+}
+
+void SolverThread::waitIdle() {
+  std::unique_lock<std::mutex> lock(mutex);
+  idle.wait(lock, [this]() { return !working && jobs.empty(); });
+}
+
+bool SolverThread::busy() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return working || !jobs.empty();
+}
+
+void SolverThread::run() {
+  TRACE_THREAD_NAME("solver");
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+    if (stopping) {
+      return;
+    }
+
+    Job job = jobs.front();
+    jobs.pop_front();
+    working = true;
+    cancelFlag = false;
+    lock.unlock();
+
+    SolveResult result;
+    result.kind = job.kind;
+    bool solved;
+    auto start = std::chrono::steady_clock::now();
+    {
+      TRACE_SCOPE("solve");
+      solved = mode == SOLVER_BIDIRECTIONAL &&
+               optimal.solve(job.state, result.moves, &cancelFlag);
+      if (!solved && !cancelFlag.load()) {
+        solved = solver.solve(job.state, result.moves, &cancelFlag);
+      }
+    }
+    result.milliseconds = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+
+    lock.lock();
+    working = false;
+    if (solved && job.generation == generation) {
+      results.push_back(std::move(result));
+    }
+    if (jobs.empty()) {
+      idle.notify_all();
+    }
+  }
+}
@@ -0,0 +1,147 @@
+#include "TableFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(TableFileHeader) == 64, "table header must be 64 bytes");
+
+static const char TABLE_MAGIC[8] = {'R', 'U', 'B', 'I', 'K', 'T', 'B', 'L'};
+
+// 校验文件头与期望的表是否一致
+static bool headerMatches(const TableFileHeader &header,
+                          const std::string &name, int bitsPerEntry,
+                          uint64_t entryCount, size_t fileSize) {
+  return std::memcmp(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) == 0 &&
+         header.version == TableFile::VERSION &&
+         header.bitsPerEntry == static_cast<uint32_t>(bitsPerEntry) &&
+         header.entryCount == entryCount &&
+         header.dataBytes + sizeof(TableFileHeader) == fileSize &&
+         header.dataBytes % sizeof(uint64_t) == 0 &&
+         std::strncmp(header.name, name.c_str(), sizeof(header.name)) == 0;
+}
+
+TableFile::TableFile() : data(nullptr), mapping(nullptr), mappedSize(0) {}
+
+TableFile::~TableFile() { close(); }
+
+uint64_t TableFile::checksum(const uint64_t *words, size_t wordCount) {
+  uint64_t hash = 0xCBF29CE484222325ULL;
+  for (size_t i = 0; i < wordCount; i++) {
+    hash ^= words[i];
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+bool TableFile::write(const std::string &path, const std::string &name,
+                      int bitsPerEntry, uint64_t entryCount,
+                      const uint64_t *words, size_t wordCount) {
+  TableFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+  header.version = VERSION;
+  header.bitsPerEntry = static_cast<uint32_t>(bitsPerEntry);
+  header.entryCount = entryCount;
+  header.dataBytes = wordCount * sizeof(uint64_t);
+  header.checksum = checksum(words, wordCount);
+  std::strncpy(header.name, name.c_str(), sizeof(header.name) - 1);
+
+  // 先写临时文件再改名，避免读者映射到写了一半的表
+  std::string tempPath = path + ".tmp";
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(words),
+              static_cast<std::streamsize>(header.dataBytes));
+    if (!out) {
+      return false;
+    }
+  }
+  std::remove(path.c_str());
+  return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+bool TableFile::open(const std::string &path, const std::string &name,
+                     int bitsPerEntry, uint64_t entryCount) {
+  close();
+
+#ifndef _WIN32
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < sizeof(TableFileHeader)) {
+    ::close(fd);
+    return false;
+  }
+
+  size_t size = static_cast<size_t>(info.st_size);
+  void *address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    return false;
+  }
+
+  mapping = address;
+  mappedSize = size;
+  const auto *header = static_cast<const TableFileHeader *>(address);
+  const auto *words = reinterpret_cast<const uint64_t *>(header + 1);
+#else
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    return false;
+  }
+  size_t size = static_cast<size_t>(in.tellg());
+  if (size < sizeof(TableFileHeader) || size % sizeof(uint64_t) != 0) {
+    return false;
+  }
+  fallback.resize(size / sizeof(uint64_t));
+  in.seekg(0);
+  in.read(reinterpret_cast<char *>(fallback.data()),
+          static_cast<std::streamsize>(size));
+  if (!in) {
+    fallback.clear();
+    return false;
+  }
+
+  mappedSize = size;
+  const auto *header =
+      reinterpret_cast<const TableFileHeader *>(fallback.data());
+  const auto *words = reinterpret_cast<const uint64_t *>(header + 1);
+#endif
+
+  if (!headerMatches(*header, name, bitsPerEntry, entryCount, mappedSize) ||
+      checksum(words, header->dataBytes / sizeof(uint64_t)) !=
+          header->checksum) {
+    close();
+    return false;
+  }
+
+  data = words;
+  return true;
+}
+
+void TableFile::close() {
+#ifndef _WIN32
+  if (mapping) {
+    munmap(mapping, mappedSize);
+  }
+#endif
+  fallback.clear();
+  mapping = nullptr;
+  mappedSize = 0;
+  data = nullptr;
+}
@@ -0,0 +1,209 @@
+#include "ThistlethwaiteSolver.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+// 各阶段可用的转动：第一阶段全部18种，之后依次把 F/B、L/R、U/D
+// 限制为半圈（Face 枚举中对面相邻，face / 2 即对面编号）
+struct PhaseMoves {
+  std::vector<Move> moves[ThistlethwaiteSolver::PHASE_COUNT];
+
+  PhaseMoves() {
+    for (int phase = 0; phase < ThistlethwaiteSolver::PHASE_COUNT; phase++) {
+      for (int index = 0; index < Move::COUNT; index++) {
+        Move move = Move::fromIndex(index);
+        if (move.face / 2 >= phase || move.turns == 2) {
+          moves[phase].push_back(move);
+        }
+      }
+    }
+  }
+};
+
+const std::vector<Move> &phaseMoves(int phase) {
+  static const PhaseMoves table;
+  return table.moves[phase];
+}
+
+struct CodeHash {
+  size_t operator()(const StateCode &code) const {
+    return static_cast<size_t>(code.hash());
+  }
+};
+
+// 双向搜索的节点：正向节点 = 父节点 * move，反向节点 = 父节点 * move⁻¹
+struct SearchNode {
+  CubeState state;
+  int parent;
+  Move move;
+  bool backward;
+};
+
+// 每展开这么多个节点检查一次取消标志
+constexpr size_t CANCEL_INTERVAL = 256;
+
+// 合并相邻的同面转动（阶段交界处可能出现 U U2 之类的序列）
+void appendMerged(std::vector<Move> &solution, const Move &move) {
+  if (!solution.empty() && solution.back().face == move.face) {
+    int turns = (solution.back().turns + move.turns) % 4;
+    solution.pop_back();
+    if (turns != 0) {
+      solution.emplace_back(static_cast<Face>(move.face), turns);
+    }
+    return;
+  }
+  solution.push_back(move);
+}
+
+} // namespace
+
+ThistlethwaiteSolver::ThistlethwaiteSolver() {
+  // 从还原状态出发，只用半圈转动遍历所有角块排列
+  std::vector<CubeState> &corners = halfTurnCorners;
+  corners.push_back(CubeState());
+  for (size_t i = 0; i < corners.size(); i++) {
+    for (const Move &move : phaseMoves(3)) {
+      CubeState next = corners[i];
+      next.apply(move);
+      bool seen = false;
+      for (const CubeState &known : corners) {
+        if (std::equal(known.cp, known.cp + 8, next.cp)) {
+          seen = true;
+          break;
+        }
+      }
+      if (!seen) {
+        corners.push_back(next);
+      }
+    }
+  }
+}
+
+StateCode ThistlethwaiteSolver::phaseKey(int phase,
+                                         const CubeState &state) const {
+  StateCode key = {0, 0};
+  switch (phase) {
+  case 0:
+    // 棱块翻转
+    for (int i = 0; i < 12; i++) {
+      key.edges |= static_cast<uint64_t>(state.eo[i]) << i;
+    }
+    break;
+  case 1:
+    // 角块朝向 + 中层（E 层）棱块所在的位置
+    for (int i = 0; i < 8; i++) {
+      key.corners = key.corners * 3 + state.co[i];
+    }
+    for (int i = 0; i < 12; i++) {
+      if (state.ep[i] >= EDGE_FR) {
+        key.edges |= 1ULL << i;
+      }
+    }
+    break;
+  case 2: {
+    // 角块排列所在的陪集（取陪集中秩最小的排列）+ M 层棱块所在的位置
+    uint32_t best = UINT32_MAX;
+    for (const CubeState &h : halfTurnCorners) {
+      uint8_t cp[8];
+      for (int i = 0; i < 8; i++) {
+        cp[i] = h.cp[state.cp[i]];
+      }
+      best = std::min(best, CubeState::rankPermutation(cp, 8));
+    }
+    key.corners = best;
+    for (int i = 0; i < 12; i++) {
+      int edge = state.ep[i];
+      if (edge == EDGE_UF || edge == EDGE_UB || edge == EDGE_DF ||
+          edge == EDGE_DB) {
+        key.edges |= 1ULL << i;
+      }
+    }
+    break;
+  }
+  default:
+    key = state.encode();
+    break;
+  }
+  return key;
+}
+
+bool ThistlethwaiteSolver::solve(const CubeState &state,
+                                 std::vector<Move> &solution,
+                                 const std::atomic<bool> *cancel) const {
+  solution.clear();
+  CubeState current = state;
+  std::vector<Move> phaseSolution;
+  for (int phase = 0; phase < PHASE_COUNT; phase++) {
+    phaseSolution.clear();
+    if (!solvePhase(phase, current, phaseSolution, cancel)) {
+      solution.clear();
+      return false;
+    }
+    for (const Move &move : phaseSolution) {
+      appendMerged(solution, move);
+    }
+  }
+  return true;
+}
+
+bool ThistlethwaiteSolver::solvePhase(int phase, CubeState &state,
+                                      std::vector<Move> &solution,
+                                      const std::atomic<bool> *cancel) const {
+  StateCode goalKey = phaseKey(phase, CubeState());
+  if (phaseKey(phase, state) == goalKey) {
+    return true;
+  }
+
+  // 陪集编号的变化只取决于编号本身和转动，因此每个编号保留一个代表状态
+  // 即可；两个方向的搜索相遇时拼出路径
+  const std::vector<Move> &moves = phaseMoves(phase);
+  std::vector<SearchNode> nodes;
+  std::unordered_map<StateCode, int, CodeHash> visited;
+  nodes.push_back(SearchNode{state, -1, Move(), false});
+  nodes.push_back(SearchNode{CubeState(), -1, Move(), true});
+  visited.emplace(phaseKey(phase, state), 0);
+  visited.emplace(goalKey, 1);
+
+  for (size_t head = 0; head < nodes.size(); head++) {
+    if (cancel && head % CANCEL_INTERVAL == 0 && cancel->load()) {
+      return false;
+    }
+
+    bool backward = nodes[head].backward;
+    for (const Move &move : moves) {
+      CubeState next = nodes[head].state;
+      next.apply(backward ? move.inverse() : move);
+      StateCode key = phaseKey(phase, next);
+
+      auto found = visited.find(key);
+      if (found == visited.end()) {
+        visited.emplace(key, static_cast<int>(nodes.size()));
+        nodes.push_back(SearchNode{next, static_cast<int>(head), move,
+                                   backward});
+        continue;
+      }
+      if (nodes[found->second].backward == backward) {
+        continue;
+      }
+
+      // 正向链 + 连接两侧的一步 + 反向链（反向节点的 move 正是走向父节点
+      // 的转动）
+      int forwardNode = backward ? found->second : static_cast<int>(head);
+      int backwardNode = backward ? static_cast<int>(head) : found->second;
+      size_t start = solution.size();
+      for (int n = forwardNode; nodes[n].parent >= 0; n = nodes[n].parent) {
+        solution.push_back(nodes[n].move);
+      }
+      std::reverse(solution.begin() + start, solution.end());
+      solution.push_back(move);
+      for (int n = backwardNode; nodes[n].parent >= 0; n = nodes[n].parent) {
+        solution.push_back(nodes[n].move);
+      }
+
+      state.applyMoves(solution.data() + start, solution.size() - start);
+      return true;
+    }
+  }
+  return false; // 起始状态不在该阶段的起始子群中（状态不合法）
+}
@@ -0,0 +1,78 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threads)
+    : current(nullptr), taskCount(0), nextTask(0), generation(0), busy(0),
+      stopping(false) {
+  if (threads <= 0) {
+    threads = static_cast<int>(
+        std::max(1u, std::thread::hardware_concurrency()));
+  }
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)> &task) {
+  if (workers.empty() || count <= 1) {
+    for (size_t i = 0; i < count; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    current = &task;
+    taskCount = count;
+    nextTask = 0;
+    busy = static_cast<int>(workers.size());
+    generation++;
+  }
+  wake.notify_all();
+
+  work();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [this]() { return busy == 0; });
+  current = nullptr;
+}
+
+void ThreadPool::work() {
+  for (size_t i = nextTask.fetch_add(1); i < taskCount;
+       i = nextTask.fetch_add(1)) {
+    (*current)(i);
+  }
+}
+
+void ThreadPool::workerLoop() {
+  uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&]() { return stopping || generation != seen; });
+      if (stopping) {
+        return;
+      }
+      seen = generation;
+    }
+
+    work();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--busy == 0) {
+      done.notify_one();
+    }
+  }
+}
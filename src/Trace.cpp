@@ -0,0 +1,112 @@
+#include "Trace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceRing {
+  std::unique_ptr<TraceEvent[]> events;
+  std::atomic<uint64_t> head; // 已写入的事件总数
+  const char *threadName;
+  int threadId;
+
+  explicit TraceRing(int id)
+      : events(new TraceEvent[Trace::RING_SIZE]), head(0),
+        threadName(nullptr), threadId(id) {}
+};
+
+// 所有线程的缓冲区；只在线程首次记录时加锁登记
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<TraceRing>> rings;
+  std::chrono::steady_clock::time_point epoch =
+      std::chrono::steady_clock::now();
+};
+
+TraceRegistry &registry() {
+  static TraceRegistry instance;
+  return instance;
+}
+
+TraceRing &localRing() {
+  thread_local TraceRing *ring = nullptr;
+  if (!ring) {
+    TraceRegistry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.rings.push_back(
+        std::make_unique<TraceRing>(static_cast<int>(reg.rings.size())));
+    ring = reg.rings.back().get();
+  }
+  return *ring;
+}
+
+void writeName(FILE *file, const char *name) {
+  std::fputc('"', file);
+  for (const char *c = name; *c; c++) {
+    if (*c == '"' || *c == '\\')
+      std::fputc('\\', file);
+    std::fputc(*c, file);
+  }
+  std::fputc('"', file);
+}
+
+} // namespace
+
+void Trace::record(const char *name, char phase) {
+  TraceRing &ring = localRing();
+  uint64_t nanos = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - registry().epoch)
+          .count());
+  uint64_t head = ring.head.load(std::memory_order_relaxed);
+  ring.events[head & (RING_SIZE - 1)] = {name, nanos, phase};
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const char *name) { localRing().threadName = name; }
+
+bool Trace::write(const std::string &path) {
+  FILE *file = std::fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+
+  TraceRegistry &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+  bool first = true;
+  for (const auto &ring : reg.rings) {
+    if (ring->threadName) {
+      std::fprintf(file,
+                   "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                   "\"tid\":%d,\"args\":{\"name\":",
+                   first ? "" : ",", ring->threadId);
+      writeName(file, ring->threadName);
+      std::fputs("}}", file);
+      first = false;
+    }
+
+    // 缓冲区被覆盖过时，开头可能有找不到开始事件的结束事件，跳过它们
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t begin = head > RING_SIZE ? head - RING_SIZE : 0;
+    int depth = 0;
+    for (uint64_t i = begin; i < head; i++) {
+      const TraceEvent &event = ring->events[i & (RING_SIZE - 1)];
+      if (event.phase == 'E' && depth == 0)
+        continue;
+      depth += event.phase == 'B' ? 1 : -1;
+
+      std::fprintf(file, "%s\n{\"name\":", first ? "" : ",");
+      writeName(file, event.name);
+      std::fprintf(file,
+                   ",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                   event.phase, event.nanos / 1000.0, ring->threadId);
+      first = false;
+    }
+  }
+  std::fputs("\n]}\n", file);
+  return std::fclose(file) == 0;
+}
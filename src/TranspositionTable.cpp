@@ -0,0 +1,84 @@
+#include "TranspositionTable.hpp"
+
+// data 字段布局：角块坐标 27 位 | 深度 8 位 | 距离 8 位 | 类型 2 位 | 占用 1 位
+static constexpr int DEPTH_SHIFT = 27;
+static constexpr int VALUE_SHIFT = 35;
+static constexpr int BOUND_SHIFT = 43;
+static constexpr uint64_t OCCUPIED_BIT = 1ULL << 45;
+static constexpr uint64_t CORNER_MASK = (1ULL << DEPTH_SHIFT) - 1;
+
+TranspositionTable::TranspositionTable(size_t capacity) {
+  size_t buckets = 1;
+  while (buckets * 4 <= capacity) {
+    buckets *= 2;
+  }
+  bucketMask = buckets - 1;
+  slots.reset(new Slot[buckets * 2]);
+  clear();
+}
+
+uint64_t TranspositionTable::pack(const StateCode &code,
+                                  const TableEntry &entry) {
+  return static_cast<uint64_t>(code.corners) |
+         static_cast<uint64_t>(entry.depth) << DEPTH_SHIFT |
+         static_cast<uint64_t>(entry.value) << VALUE_SHIFT |
+         static_cast<uint64_t>(entry.bound & 3) << BOUND_SHIFT | OCCUPIED_BIT;
+}
+
+bool TranspositionTable::matches(const StateCode &code, uint64_t check,
+                                 uint64_t data) {
+  return (data & OCCUPIED_BIT) && (data & CORNER_MASK) == code.corners &&
+         (check ^ data) == code.edges;
+}
+
+TableEntry TranspositionTable::unpack(uint64_t data) {
+  TableEntry entry;
+  entry.depth = static_cast<uint8_t>(data >> DEPTH_SHIFT);
+  entry.value = static_cast<uint8_t>(data >> VALUE_SHIFT);
+  entry.bound = static_cast<BoundType>((data >> BOUND_SHIFT) & 3);
+  return entry;
+}
+
+bool TranspositionTable::probe(const StateCode &code, TableEntry &entry) const {
+  const Slot *bucket = &slots[(code.hash() & bucketMask) * 2];
+  for (int i = 0; i < 2; i++) {
+    uint64_t data = bucket[i].data.load(std::memory_order_relaxed);
+    uint64_t check = bucket[i].check.load(std::memory_order_relaxed);
+    if (matches(code, check, data)) {
+      entry = unpack(data);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TranspositionTable::store(const StateCode &code, const TableEntry &entry) {
+  Slot *bucket = &slots[(code.hash() & bucketMask) * 2];
+
+  // 同键优先覆盖；否则深度不低于第一个槽位时替换它，其余写入第二个槽位
+  Slot *target = nullptr;
+  for (int i = 0; i < 2 && !target; i++) {
+    uint64_t data = bucket[i].data.load(std::memory_order_relaxed);
+    uint64_t check = bucket[i].check.load(std::memory_order_relaxed);
+    if (matches(code, check, data)) {
+      target = &bucket[i];
+    }
+  }
+  if (!target) {
+    uint64_t data = bucket[0].data.load(std::memory_order_relaxed);
+    bool replaceFirst =
+        !(data & OCCUPIED_BIT) || entry.depth >= unpack(data).depth;
+    target = replaceFirst ? &bucket[0] : &bucket[1];
+  }
+
+  uint64_t data = pack(code, entry);
+  target->data.store(data, std::memory_order_relaxed);
+  target->check.store(code.edges ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+  for (size_t i = 0; i < (bucketMask + 1) * 2; i++) {
+    slots[i].data.store(0, std::memory_order_relaxed);
+    slots[i].check.store(0, std::memory_order_relaxed);
+  }
+}
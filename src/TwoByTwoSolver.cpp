@@ -0,0 +1,248 @@
+#include "TwoByTwoSolver.hpp"
+#include "RotationGroup.hpp"
+
+namespace {
+
+constexpr uint32_t PERM_COUNT = 5040; // 7!
+constexpr uint32_t TWIST_COUNT = 729; // 3^6
+
+const char *const TABLE_NAME = "2x2x2-distance-mod3";
+
+// 参与置换的7个角块位置（DBL 固定不动）
+const int SLOTS[7] = {CORNER_URF, CORNER_UFL, CORNER_ULB, CORNER_UBR,
+                      CORNER_DFR, CORNER_DLF, CORNER_DRB};
+const int LOCAL[8] = {0, 1, 2, 3, 4, 5, -1, 6};
+
+const Move MOVES[TwoByTwoSolver::MOVE_COUNT] = {
+    Move(FACE_U, 1), Move(FACE_U, 2), Move(FACE_U, 3),
+    Move(FACE_R, 1), Move(FACE_R, 2), Move(FACE_R, 3),
+    Move(FACE_F, 1), Move(FACE_F, 2), Move(FACE_F, 3)};
+
+// 排列部分与朝向部分各自独立变化，分别建表
+struct MoveTables {
+  uint16_t perm[PERM_COUNT][TwoByTwoSolver::MOVE_COUNT];
+  uint16_t twist[TWIST_COUNT][TwoByTwoSolver::MOVE_COUNT];
+
+  MoveTables() {
+    for (uint32_t p = 0; p < PERM_COUNT; p++) {
+      uint8_t local[7];
+      CubeState::unrankPermutation(p, local, 7);
+      for (int m = 0; m < TwoByTwoSolver::MOVE_COUNT; m++) {
+        CubeState state;
+        for (int k = 0; k < 7; k++) {
+          state.cp[SLOTS[k]] = static_cast<uint8_t>(SLOTS[local[k]]);
+        }
+        state.apply(MOVES[m]);
+        uint8_t moved[7];
+        for (int k = 0; k < 7; k++) {
+          moved[k] = static_cast<uint8_t>(LOCAL[state.cp[SLOTS[k]]]);
+        }
+        perm[p][m] =
+            static_cast<uint16_t>(CubeState::rankPermutation(moved, 7));
+      }
+    }
+
+    for (uint32_t t = 0; t < TWIST_COUNT; t++) {
+      for (int m = 0; m < TwoByTwoSolver::MOVE_COUNT; m++) {
+        CubeState state;
+        uint32_t rest = t;
+        int sum = 0;
+        for (int k = 5; k >= 0; k--) {
+          state.co[SLOTS[k]] = static_cast<uint8_t>(rest % 3);
+          sum += rest % 3;
+          rest /= 3;
+        }
+        state.co[SLOTS[6]] = static_cast<uint8_t>((3 - sum % 3) % 3);
+        state.apply(MOVES[m]);
+
+        uint32_t moved = 0;
+        for (int k = 0; k < 6; k++) {
+          moved = moved * 3 + state.co[SLOTS[k]];
+        }
+        twist[t][m] = static_cast<uint16_t>(moved);
+      }
+    }
+  }
+
+  uint32_t next(uint32_t index, int m) const {
+    return perm[index / TWIST_COUNT][m] * TWIST_COUNT +
+           twist[index % TWIST_COUNT][m];
+  }
+};
+
+const MoveTables &moveTables() {
+  static const MoveTables instance;
+  return instance;
+}
+
+// 整体转动魔方对应的块级状态
+CubeState rotationState(int rotation) {
+  CubeState state;
+  for (int i = 0; i < 8; i++) {
+    Vector3 position =
+        RotationGroup::apply(rotation, CubeState::cornerPosition(i));
+    Vector3 reference = RotationGroup::apply(
+        rotation, Move::faceAxis(CubeState::CORNER_FACES[i][0]));
+    for (int j = 0; j < 8; j++) {
+      if (!(CubeState::cornerPosition(j) == position))
+        continue;
+      state.cp[j] = static_cast<uint8_t>(i);
+      for (int k = 0; k < 3; k++) {
+        if (Move::faceAxis(CubeState::CORNER_FACES[j][k]) == reference)
+          state.co[j] = static_cast<uint8_t>(k);
+      }
+    }
+  }
+  for (int i = 0; i < 12; i++) {
+    Vector3 position =
+        RotationGroup::apply(rotation, CubeState::edgePosition(i));
+    Vector3 reference = RotationGroup::apply(
+        rotation, Move::faceAxis(CubeState::EDGE_FACES[i][0]));
+    for (int j = 0; j < 12; j++) {
+      if (!(CubeState::edgePosition(j) == position))
+        continue;
+      state.ep[j] = static_cast<uint8_t>(i);
+      state.eo[j] =
+          Move::faceAxis(CubeState::EDGE_FACES[j][0]) == reference ? 0 : 1;
+    }
+  }
+  return state;
+}
+
+// 24个整体转动状态，以及每个转动下9种转动换回原朝向后的结果
+struct RotationTables {
+  CubeState states[RotationGroup::SIZE];
+  Move translated[RotationGroup::SIZE][TwoByTwoSolver::MOVE_COUNT];
+
+  RotationTables() {
+    for (int r = 0; r < RotationGroup::SIZE; r++) {
+      states[r] = rotationState(r);
+      CubeState inverse = states[r].inverse();
+
+      // W·m·W⁻¹ 仍是一次面转动
+      for (int m = 0; m < TwoByTwoSolver::MOVE_COUNT; m++) {
+        CubeState conjugated = CubeState::multiply(
+            CubeState::multiply(states[r], CubeState::moveState(MOVES[m])),
+            inverse);
+        for (int n = 0; n < Move::COUNT; n++) {
+          if (CubeState::moveState(Move::fromIndex(n)) == conjugated)
+            translated[r][m] = Move::fromIndex(n);
+        }
+      }
+    }
+  }
+};
+
+const RotationTables &rotationTables() {
+  static const RotationTables instance;
+  return instance;
+}
+
+} // namespace
+
+TwoByTwoSolver::TwoByTwoSolver() : words(nullptr) {}
+
+BuildStats TwoByTwoSolver::generate(int threads) {
+  const MoveTables &tables = moveTables();
+  auto table = std::make_unique<PackedTable>(STATE_COUNT, 2);
+
+  BuildStats stats = TableBuilder::build(
+      *table, 0,
+      [&tables](uint64_t index, auto &&visit) {
+        for (int m = 0; m < MOVE_COUNT; m++) {
+          if (visit(tables.next(static_cast<uint32_t>(index), m)))
+            return;
+        }
+      },
+      threads);
+
+  mapped.close();
+  generated = std::move(table);
+  words = generated->data();
+  return stats;
+}
+
+bool TwoByTwoSolver::save(const std::string &path) const {
+  if (!words) {
+    return false;
+  }
+  return TableFile::write(path, TABLE_NAME, 2, STATE_COUNT, words,
+                          (STATE_COUNT + 31) / 32);
+}
+
+bool TwoByTwoSolver::load(const std::string &path) {
+  if (!mapped.open(path, TABLE_NAME, 2, STATE_COUNT)) {
+    return false;
+  }
+  generated.reset();
+  words = mapped.words();
+  return true;
+}
+
+uint32_t TwoByTwoSolver::indexOf(const CubeState &state) {
+  uint8_t local[7];
+  for (int k = 0; k < 7; k++) {
+    local[k] = static_cast<uint8_t>(LOCAL[state.cp[SLOTS[k]]]);
+  }
+
+  uint32_t twist = 0;
+  for (int k = 0; k < 6; k++) {
+    twist = twist * 3 + state.co[SLOTS[k]];
+  }
+
+  return CubeState::rankPermutation(local, 7) * TWIST_COUNT + twist;
+}
+
+std::vector<Move> TwoByTwoSolver::descend(uint32_t index, int rotation) const {
+  const MoveTables &tables = moveTables();
+  const Move *translated = rotationTables().translated[rotation];
+  std::vector<Move> moves;
+
+  int value = valueAt(index);
+  if (value == 3) {
+    return moves;
+  }
+
+  while (index != 0) {
+    int target = (value + 2) % 3;
+    bool stepped = false;
+    for (int m = 0; m < MOVE_COUNT && !stepped; m++) {
+      uint32_t next = tables.next(index, m);
+      if (valueAt(next) == target) {
+        moves.push_back(translated[m]);
+        index = next;
+        value = target;
+        stepped = true;
+      }
+    }
+    if (!stepped) {
+      break; // 表已损坏
+    }
+  }
+  return moves;
+}
+
+std::vector<Move> TwoByTwoSolver::solve(const CubeState &state) const {
+  if (!words) {
+    return {};
+  }
+
+  // 整体转动魔方，使 DBL 角块回到 DBL 位置且朝向为0；
+  // 在转动后的朝向里求解，每一步再换回原朝向
+  const RotationTables &rotations = rotationTables();
+  for (int r = 0; r < RotationGroup::SIZE; r++) {
+    CubeState oriented = CubeState::multiply(state, rotations.states[r]);
+    if (oriented.cp[CORNER_DBL] == CORNER_DBL &&
+        oriented.co[CORNER_DBL] == 0) {
+      return descend(indexOf(oriented), r);
+    }
+  }
+  return {};
+}
+
+int TwoByTwoSolver::distance(const CubeState &state) const {
+  if (!words) {
+    return -1;
+  }
+  return static_cast<int>(solve(state).size());
+}
@@ -1,14 +1,211 @@
+#include "AnsiRenderer.hpp"
+#include "AsciicastRecorder.hpp"
+#include "CellBuffer.hpp"
+#include "CubeFormat.hpp"
+#include "CubeGrid.hpp"
+#include "CursesRenderer.hpp"
+#include "InputHandler.hpp"
+#include "InputLog.hpp"
+#include "OutputThread.hpp"
 #include "RubiksCube.hpp"
+#include "SolverThread.hpp"
+#include "Trace.hpp"
+#include <atomic>
 #include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
+#include <io.h>
 #include <pdcurses.h>
 #else
 #include <curses.h>
+#include <unistd.h>
 #endif
 
+#ifdef RUBIK_SERVER
+#include "CubeServer.hpp"
+#endif
+
+#ifdef RUBIK_COUNT_ALLOCATIONS
+#include "AllocationCounter.hpp"
+#endif
+
+// 退出时导出分阶段帧耗时统计的文件
+static const char *const FRAME_STATS_PATH = "frame_stats.txt";
+#ifdef RUBIK_TRACE
+// 退出时导出时间线的文件
+static const char *const TRACE_PATH = "rubik_trace.json";
+#endif
+
+// 无终端回放时每帧推进的模拟时间（60 FPS）
+static const std::chrono::nanoseconds FRAME_STEP(16666667);
+
+/**
+ * @struct Options
+ * @brief 命令行选项
+ */
+struct Options {
+  std::string replayPath; ///< 回放的输入日志
+  std::string recordPath; ///< 记录输入日志的文件
+  bool headless = false;  ///< 不使用终端，只渲染到离屏缓冲区
+  int width = 120;        ///< 无终端时的画面宽度
+  int height = 40;        ///< 无终端时的画面高度
+  uint64_t frames = 0;    ///< 无终端时的帧数（0：日志结束后再渲染60帧）
+  bool seedGiven = false; ///< 是否指定了随机种子
+  uint32_t seed = 0;      ///< 随机种子
+  std::string renderer;   ///< 输出后端（空：交互为 curses，无终端为 null）
+  int gridColumns = 0;    ///< 多魔方视图的列数（0：单魔方）
+  int gridRows = 0;       ///< 多魔方视图的行数
+  int threads = 0;        ///< 多魔方视图的渲染线程数（0：硬件并发数）
+  std::string servePath;  ///< 控制服务器的套接字路径（空：不启动）
+  std::string castPath;   ///< 录制 asciicast 的文件（空：不录制）
+  int quality = -1;       ///< 固定的画质档位（-1：交互时按预算自动调整）
+  double budgetMs = 16.0; ///< 自动调整画质时每帧的耗时预算（毫秒）
+  std::string stateText;  ///< 初始状态的文本（空：从还原状态开始）
+  CubeState state;        ///< 解析后的初始状态
+  SolverMode solverMode = SOLVER_THISTLETHWAITE; ///< 提示与自动还原的求解方法
+  size_t solverMemoryMb = BidirectionalSolver::DEFAULT_MEMORY_MB; ///< 内存上限
+  int solverDepth = 11; ///< 双向搜索的步数上限
+};
+
+static void printUsage() {
+  std::cout << "Usage: rubik [options]" << std::endl;
+  std::cout << "  --record FILE   Record key and mouse input to FILE"
+            << std::endl;
+  std::cout << "  --replay FILE   Feed recorded input from FILE" << std::endl;
+  std::cout << "  --headless      Render off-screen in fixed 1/60 s steps and"
+            << std::endl;
+  std::cout << "                  print a hash per frame (needs --replay)"
+            << std::endl;
+  std::cout << "  --size WxH      Off-screen size (default: 120x40)"
+            << std::endl;
+  std::cout << "  --frames N      Number of frames to render headless"
+            << std::endl;
+  std::cout << "  --seed N        Random seed used by scramble" << std::endl;
+  std::cout << "  --renderer NAME Output backend: curses (default), ansi or"
+            << std::endl;
+  std::cout << "                  null; headless accepts ansi and null"
+            << std::endl;
+  std::cout << "  --grid CxR      Show a wall of C x R cubes playing scrambles"
+            << std::endl;
+  std::cout << "                  (headless does not need --replay)"
+            << std::endl;
+  std::cout << "  --threads N     Render threads for --grid (default: all)"
+            << std::endl;
+  std::cout << "  --serve PATH    Run the control server on a Unix socket"
+            << std::endl;
+  std::cout << "  --cast FILE     Record the screen to FILE (asciicast v2)"
+            << std::endl;
+  std::cout << "  --quality N     Fixed quality level 0-4 (default: adapt to"
+            << std::endl;
+  std::cout << "                  the frame budget; headless: 0)" << std::endl;
+  std::cout << "  --budget MS     Frame time budget (default: 16)" << std::endl;
+  std::cout << "  --state TEXT    Start from a facelet string (URFDLB order)"
+            << std::endl;
+  std::cout << "                  or cubie notation (\"UF UR ... DBR\")"
+            << std::endl;
+  std::cout << "  --solver NAME   Hint/solve method: thistlethwaite (default)"
+            << std::endl;
+  std::cout << "                  or bidirectional (optimal, short distances)"
+            << std::endl;
+  std::cout << "  --solver-memory MB" << std::endl;
+  std::cout << "                  Memory cap for bidirectional (default: 1024)"
+            << std::endl;
+  std::cout << "  --solver-depth N" << std::endl;
+  std::cout << "                  Longest solution bidirectional tries"
+            << std::endl;
+  std::cout << "                  (default: 11). Farther states fall back to"
+            << std::endl;
+  std::cout << "                  thistlethwaite after ~0.3 s (~3 s at 12)."
+            << std::endl;
+  std::cout << "                  The first hint also builds a cache (~3 s)."
+            << std::endl;
+}
+
+static bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--replay" && hasValue) {
+      options.replayPath = argv[++i];
+    } else if (arg == "--record" && hasValue) {
+      options.recordPath = argv[++i];
+    } else if (arg == "--headless") {
+      options.headless = true;
+    } else if (arg == "--size" && hasValue) {
+      if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) !=
+              2 ||
+          options.width <= 0 || options.height <= 0) {
+        return false;
+      }
+    } else if (arg == "--frames" && hasValue) {
+      options.frames = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--seed" && hasValue) {
+      options.seed =
+          static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      options.seedGiven = true;
+    } else if (arg == "--renderer" && hasValue) {
+      options.renderer = argv[++i];
+    } else if (arg == "--grid" && hasValue) {
+      if (std::sscanf(argv[++i], "%dx%d", &options.gridColumns,
+                      &options.gridRows) != 2 ||
+          options.gridColumns <= 0 || options.gridRows <= 0) {
+        return false;
+      }
+    } else if (arg == "--threads" && hasValue) {
+      options.threads = std::atoi(argv[++i]);
+    } else if (arg == "--serve" && hasValue) {
+      options.servePath = argv[++i];
+    } else if (arg == "--cast" && hasValue) {
+      options.castPath = argv[++i];
+    } else if (arg == "--quality" && hasValue) {
+      options.quality = std::atoi(argv[++i]);
+      if (options.quality < 0 || options.quality >= QUALITY_COUNT) {
+        return false;
+      }
+    } else if (arg == "--state" && hasValue) {
+      options.stateText = argv[++i];
+    } else if (arg == "--solver" && hasValue) {
+      std::string name = argv[++i];
+      if (name == "thistlethwaite") {
+        options.solverMode = SOLVER_THISTLETHWAITE;
+      } else if (name == "bidirectional") {
+        options.solverMode = SOLVER_BIDIRECTIONAL;
+      } else {
+        return false;
+      }
+    } else if (arg == "--solver-memory" && hasValue) {
+      options.solverMemoryMb = std::strtoull(argv[++i], nullptr, 10);
+      if (options.solverMemoryMb == 0) {
+        return false;
+      }
+    } else if (arg == "--solver-depth" && hasValue) {
+      options.solverDepth = std::atoi(argv[++i]);
+      if (options.solverDepth <= 0) {
+        return false;
+      }
+    } else if (arg == "--budget" && hasValue) {
+      options.budgetMs = std::atof(argv[++i]);
+      if (options.budgetMs <= 0) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return !options.headless || !options.replayPath.empty() ||
+         options.gridColumns > 0;
+}
+
 void printInstructions() {
   std::cout << "======================================" << std::endl;
   std::cout << "      3x3 Rubik's Cube Simulator      " << std::endl;
@@ -16,9 +213,14 @@ void printInstructions() {
   std::cout << std::endl;
   std::cout << "Controls:" << std::endl;
   std::cout << "  Arrow Keys - Rotate cube" << std::endl;
+  std::cout << "  Drag       - Rotate cube (on a sticker: turn its layer)"
+            << std::endl;
   std::cout << "  +/-        - Zoom in/out" << std::endl;
   std::cout << "  C          - Reset cube" << std::endl;
   std::cout << "  X          - Scramble cube" << std::endl;
+  std::cout << "  T          - Toggle timing panel" << std::endl;
+  std::cout << "  H          - Hint (play next move)" << std::endl;
+  std::cout << "  S          - Solve automatically" << std::endl;
   std::cout << "  ESC        - Exit" << std::endl;
   std::cout << std::endl;
   std::cout << "Rotate faces (based on current view):" << std::endl;
@@ -38,8 +240,253 @@ void printInstructions() {
   std::cin.ignore();
 }
 
-int main() {
-  printInstructions();
+// 把 ncurses 的输入转换为 InputEvent，无法识别的输入返回false
+static bool translateInput(int ch, InputEvent &event) {
+  event = InputEvent{INPUT_KEY, ch, 0, 0};
+  if (ch == KEY_MOUSE) {
+    MEVENT mouse;
+    if (getmouse(&mouse) != OK) {
+      return false;
+    }
+    event.x = mouse.x;
+    event.y = mouse.y;
+    if (mouse.bstate & BUTTON1_PRESSED) {
+      event.type = INPUT_MOUSE_PRESS;
+    } else if (mouse.bstate & BUTTON1_RELEASED) {
+      event.type = INPUT_MOUSE_RELEASE;
+    } else if (mouse.bstate & REPORT_MOUSE_POSITION) {
+      event.type = INPUT_MOUSE_MOVE;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  switch (ch) {
+  case KEY_UP:
+    event.key = INPUT_KEY_UP;
+    return true;
+  case KEY_DOWN:
+    event.key = INPUT_KEY_DOWN;
+    return true;
+  case KEY_LEFT:
+    event.key = INPUT_KEY_LEFT;
+    return true;
+  case KEY_RIGHT:
+    event.key = INPUT_KEY_RIGHT;
+    return true;
+  default:
+    return ch == INPUT_KEY_ESCAPE || (ch > ' ' && ch < 127);
+  }
+}
+
+// 按名称创建输出后端；headless 下没有终端，只能选 null 或 ansi
+static std::unique_ptr<Renderer> createRenderer(const std::string &name,
+                                                bool headless) {
+  if (name == "null") {
+    return std::unique_ptr<Renderer>(new NullRenderer());
+  }
+  if (name == "ansi") {
+    // 无终端时写到 /dev/null，只衡量编码和 write() 的开销
+    int fd = headless ? open("/dev/null", O_WRONLY) : fileno(stdout);
+    return fd < 0 ? nullptr : std::unique_ptr<Renderer>(new AnsiRenderer(fd));
+  }
+  if (name == "curses" && !headless) {
+    return std::unique_ptr<Renderer>(new CursesRenderer());
+  }
+  return nullptr;
+}
+
+// 写完录像并输出帧数和文件大小
+static void printCastSummary(AsciicastRecorder &cast,
+                             const std::string &path) {
+  if (!cast.close()) {
+    std::cerr << "Error writing " << path << std::endl;
+    return;
+  }
+  std::printf("Recording written to %s (%llu frames, %llu bytes, "
+              "%llu dropped)\n",
+              path.c_str(),
+              static_cast<unsigned long long>(cast.framesWritten()),
+              static_cast<unsigned long long>(cast.bytesWritten()),
+              static_cast<unsigned long long>(cast.framesDropped()));
+}
+
+// 无终端回放：每帧推进固定的模拟时间，渲染到离屏缓冲区并输出每帧的哈希
+static int runHeadless(const Options &options,
+                       const std::vector<InputRecord> &records, uint32_t seed,
+                       Renderer &renderer) {
+  RubiksCube cube;
+  cube.setRandomSeed(seed);
+  if (!options.stateText.empty()) {
+    cube.setState(options.state);
+  }
+  if (options.quality >= 0) {
+    cube.getGovernor().setLevel(static_cast<QualityLevel>(options.quality));
+  }
+
+  SolverThread solver(options.solverMode, options.solverMemoryMb << 20,
+                      options.solverDepth);
+  InputHandler input(cube, &solver);
+  CellBuffer buffer(options.width, options.height);
+  AsciicastRecorder cast;
+  if (!options.castPath.empty() && !cast.open(options.castPath)) {
+    std::cerr << "Cannot create " << options.castPath << std::endl;
+    return 1;
+  }
+  uint64_t frames = options.frames;
+  if (frames == 0) {
+    frames = (records.empty() ? 0 : records.back().frame) + 60;
+  }
+
+  std::vector<uint64_t> hashes;
+  hashes.reserve(frames);
+  size_t arenaPeak = 0;          // draw() 一帧从 arena 分配的最大字节数
+  size_t arenaFirstGrows = 0;    // 第一帧之后 arena 的增长次数以此为起点
+#ifdef RUBIK_COUNT_ALLOCATIONS
+  uint64_t drawAllocations = 0;  // 所有帧 draw() 中的堆分配次数
+  uint64_t allocatingFrames = 0; // draw() 中有堆分配的帧数
+  uint64_t firstAllocations = 0; // 第一帧（arena 等首次分配）的分配次数
+#endif
+  size_t next = 0;
+  bool running = true;
+  uint64_t frameHash = buffer.hash(); // 最近绘制的一帧（跳过的帧沿用）
+
+  TRACE_THREAD_NAME("main");
+
+  auto begin = std::chrono::steady_clock::now();
+  for (uint64_t frame = 0; frame < frames && running; frame++) {
+    for (; next < records.size() && records[next].frame <= frame; next++) {
+      cube.getFrameStats().count(COUNTER_INPUT_EVENTS);
+      running = input.handle(records[next].event) && running;
+    }
+    if (!running) {
+      break;
+    }
+    input.flush();
+    // 等求解完成再取结果，解开始播放的帧与求解耗时无关，回放结果确定
+    solver.waitIdle();
+    input.applySolverResults();
+    // 录像队列满时在这里等写入线程，下面的 record() 不会跳帧；等待不计入
+    // 帧耗时
+    cast.waitForSpace();
+
+    // 帧耗时 = 模拟、绘制、输出与交给录像，不含计算回放哈希
+    bool drawn = false;
+    auto frameStart = std::chrono::steady_clock::now();
+    {
+      TRACE_SCOPE("frame");
+      cube.update(FRAME_STEP);
+      cube.getFrameStats().endFrame(
+          std::chrono::duration<double, std::micro>(FRAME_STEP).count());
+      // 降低帧率的档位下隔帧不绘制，画面保持上一帧
+      if (!cube.getGovernor().skipFrame(frame)) {
+#ifdef RUBIK_COUNT_ALLOCATIONS
+        uint64_t before = AllocationCounter::count();
+        cube.draw(buffer);
+        uint64_t allocations = AllocationCounter::count() - before;
+        drawAllocations += allocations;
+        allocatingFrames += allocations > 0 ? 1 : 0;
+        if (frame == 0) {
+          firstAllocations = allocations;
+        }
+#else
+        cube.draw(buffer);
+#endif
+        const FrameArena &arena = cube.getFrameArena();
+        arenaPeak = std::max(arenaPeak, arena.bytesUsed());
+        if (frame == 0) {
+          arenaFirstGrows = arena.growCount();
+        }
+        ScopedTimer presentTimer(cube.getFrameStats(), STAGE_REFRESH);
+        TRACE_SCOPE("present");
+        renderer.present(buffer);
+        drawn = true;
+      }
+    }
+    double frameMicros = std::chrono::duration<double, std::micro>(
+                             std::chrono::steady_clock::now() - frameStart)
+                             .count();
+    if (drawn) {
+      frameHash = buffer.hash();
+      // record() 换走 buffer 的内容，所以放在算完哈希之后
+      auto recordStart = std::chrono::steady_clock::now();
+      cast.record(buffer, std::chrono::duration<double>(FRAME_STEP).count() *
+                              static_cast<double>(frame));
+      frameMicros += std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - recordStart)
+                         .count();
+    }
+    cube.getFrameStats().record(STAGE_FRAME, frameMicros);
+    hashes.push_back(frameHash);
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - begin)
+                       .count();
+
+  // 所有帧哈希再做一次 FNV-1a，作为整段回放的指纹
+  uint64_t combined = 0xCBF29CE484222325ULL;
+  for (size_t i = 0; i < hashes.size(); i++) {
+    std::printf("frame %6zu %016llx\n", i,
+                static_cast<unsigned long long>(hashes[i]));
+    combined = (combined ^ hashes[i]) * 0x100000001B3ULL;
+  }
+
+  const FrameStats &stats = cube.getFrameStats();
+  std::printf("frames: %zu  time: %.3f s  fps: %.1f\n", hashes.size(), seconds,
+              seconds > 0 ? hashes.size() / seconds : 0.0);
+  std::printf("frame p50: %.3f ms  p99: %.3f ms  max: %.3f ms\n",
+              stats.percentile(STAGE_FRAME, 0.5) / 1000.0,
+              stats.percentile(STAGE_FRAME, 0.99) / 1000.0,
+              stats.maximum(STAGE_FRAME) / 1000.0);
+  const FrameArena &arena = cube.getFrameArena();
+  std::printf("draw arena: peak %zu bytes  capacity %zu  grows after first "
+              "frame %zu\n",
+              arenaPeak, arena.capacity(),
+              arena.growCount() - arenaFirstGrows);
+#ifdef RUBIK_COUNT_ALLOCATIONS
+  std::printf("draw allocations: first frame %llu  later frames %llu "
+              "(in %llu frames)\n",
+              static_cast<unsigned long long>(firstAllocations),
+              static_cast<unsigned long long>(drawAllocations -
+                                              firstAllocations),
+              static_cast<unsigned long long>(
+                  allocatingFrames - (firstAllocations > 0 ? 1 : 0)));
+#endif
+  std::printf("renderer: %s  bytes written: %llu\n", renderer.name(),
+              static_cast<unsigned long long>(renderer.bytesWritten()));
+  std::printf("replay hash: %016llx\n",
+              static_cast<unsigned long long>(combined));
+  std::printf("final state: %s\n",
+              CubeFormat::toFacelets(cube.getState()).c_str());
+  if (cast.isOpen()) {
+    printCastSummary(cast, options.castPath);
+  }
+  cube.getFrameStats().writeReport(FRAME_STATS_PATH);
+#ifdef RUBIK_TRACE
+  TRACE_WRITE(TRACE_PATH);
+#endif
+  return 0;
+}
+
+static int runInteractive(const Options &options,
+                          const std::vector<InputRecord> &records,
+                          uint32_t seed, Renderer &renderer) {
+  InputLog recorder;
+  if (!options.recordPath.empty() &&
+      !recorder.create(options.recordPath, seed)) {
+    std::cerr << "Cannot create " << options.recordPath << std::endl;
+    return 1;
+  }
+  AsciicastRecorder cast;
+  if (!options.castPath.empty() && !cast.open(options.castPath)) {
+    std::cerr << "Cannot create " << options.castPath << std::endl;
+    return 1;
+  }
+
+  if (options.replayPath.empty()) {
+    printInstructions();
+  }
 
   // Initialize ncurses
   initscr();
@@ -65,99 +512,128 @@ int main() {
 
   // Create cube
   RubiksCube cube;
-  std::map<int, int> colorCache;
+  cube.setRandomSeed(seed);
+  if (!options.stateText.empty()) {
+    cube.setState(options.state);
+  }
+  FrameGovernor &governor = cube.getGovernor();
+  if (options.quality >= 0) {
+    governor.setLevel(static_cast<QualityLevel>(options.quality));
+  } else {
+    governor.setAdaptive(options.budgetMs * 1000.0);
+  }
+  SolverThread solver(options.solverMode, options.solverMemoryMb << 20,
+                      options.solverDepth);
+  InputHandler input(cube, &solver);
+  CellBuffer buffer;
+  uint64_t frame = 0;
+  size_t next = 0;
+  auto lastUpdate = std::chrono::steady_clock::now();
+  auto castStart = lastUpdate;
+
+  TRACE_THREAD_NAME("main");
 
   try {
-    while (true) {
-      int ch = getch();
-
-      if (ch == KEY_MOUSE) {
-        MEVENT event;
-        if (getmouse(&event) == OK) {
-          static int prev_x = -1, prev_y = -1;
-          static bool dragging = false;
-
-          if (event.bstate & BUTTON1_PRESSED) {
-            dragging = true;
-            prev_x = event.x;
-            prev_y = event.y;
-          } else if (event.bstate & BUTTON1_RELEASED) {
-            dragging = false;
-          } else if (dragging && (event.bstate & REPORT_MOUSE_POSITION)) {
-            int dx = event.x - prev_x;
-            int dy = event.y - prev_y;
-            if (dx != 0 || dy != 0) {
-              cube.rotateByMouseDelta(static_cast<float>(4 * dx),
-                                      static_cast<float>(8 * dy));
-              prev_x = event.x;
-              prev_y = event.y;
-            }
+    // 支持时在输出线程上写终端，主线程不必等待输出完成就能处理下一帧；
+    // 离开 try 块时结束线程，保证 endwin() 之前不再有输出
+    std::unique_ptr<OutputThread> output;
+    if (renderer.supportsOutputThread()) {
+      output.reset(new OutputThread(renderer));
+      // 录像在输出线程上、每帧输出之后进行，被输出线程丢弃的帧不录
+      if (cast.isOpen()) {
+        output->setRecorder(&cast, castStart);
+      }
+    }
+
+    bool running = true;
+    while (running) {
+      TRACE_SCOPE("loop");
+      {
+        // 一次取完所有积压的事件，拖动位移在 flush() 中合并成一次旋转
+        TRACE_SCOPE("input");
+        int ch;
+        while (running && (ch = getch()) != ERR) {
+          InputEvent event;
+          if (translateInput(ch, event)) {
+            recorder.append(frame, event);
+            cube.getFrameStats().count(COUNTER_INPUT_EVENTS);
+            running = input.handle(event);
           }
         }
-        continue; // 跳过后续键盘处理
       }
-
-      if (ch == 27 || ch == 'q') { // ESC
+      if (!running) {
         break;
-      } else if (ch == 'c' || ch == 'C') {
-        cube.reset();
-      } else if (ch == 'x' || ch == 'X') {
-        cube.scramble(20);
-      } else if (ch == KEY_UP) {
-        cube.rotateByMouseDelta(0, -10);
-      } else if (ch == KEY_DOWN) {
-        cube.rotateByMouseDelta(0, 10);
-      } else if (ch == KEY_LEFT) {
-        cube.rotateByMouseDelta(-10, 0);
-      } else if (ch == KEY_RIGHT) {
-        cube.rotateByMouseDelta(10, 0);
-      } else if (ch == '+' || ch == '=') {
-        cube.zoom(1);
-      } else if (ch == '-' || ch == '_') {
-        cube.zoom(-1);
-      } else if (ch == 'f') {
-        cube.rotateViewDirection("F", true);
-      } else if (ch == 'F') {
-        cube.rotateViewDirection("F", false);
-      } else if (ch == 'b') {
-        cube.rotateViewDirection("B", true);
-      } else if (ch == 'B') {
-        cube.rotateViewDirection("B", false);
-      } else if (ch == 'l') {
-        cube.rotateViewDirection("L", true);
-      } else if (ch == 'L') {
-        cube.rotateViewDirection("L", false);
-      } else if (ch == 'r') {
-        cube.rotateViewDirection("R", true);
-      } else if (ch == 'R') {
-        cube.rotateViewDirection("R", false);
-      } else if (ch == 'u') {
-        cube.rotateViewDirection("U", true);
-      } else if (ch == 'U') {
-        cube.rotateViewDirection("U", false);
-      } else if (ch == 'd') {
-        cube.rotateViewDirection("D", true);
-      } else if (ch == 'D') {
-        cube.rotateViewDirection("D", false);
       }
 
       int width, height;
       getmaxyx(stdscr, height, width);
 
       if (width < 80 || height < 40) {
+        if (output) {
+          output->waitIdle(); // 输出线程写完之前不能动终端
+        }
         clear();
         std::string msg = "Please resize terminal to at least 80x40";
         mvprintw(height / 2,
                  std::max(0, (width - static_cast<int>(msg.length())) / 2),
                  "%s", msg.c_str());
         refresh();
+        renderer.invalidate();
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
         continue;
       }
 
-      cube.draw(stdscr, width, height, colorCache);
-      refresh();
+      // 回放日志中属于本帧的事件
+      for (; next < records.size() && records[next].frame <= frame; next++) {
+        cube.getFrameStats().count(COUNTER_INPUT_EVENTS);
+        running = input.handle(records[next].event) && running;
+      }
+      input.flush();
+      input.applySolverResults();
 
+      // 有输出线程时绘制到它交出的缓冲区，三个缓冲区轮流使用
+      CellBuffer &target = output ? output->frame() : buffer;
+      if (target.width() != width || target.height() != height) {
+        target.resize(width, height);
+      }
+
+      // 降低帧率的档位下隔帧只推进模拟，不绘制也不输出
+      bool render = !governor.skipFrame(frame);
+      bool dropped = false;
+      auto frameStart = std::chrono::steady_clock::now();
+      {
+        ScopedTimer frameTimer(cube.getFrameStats(), STAGE_FRAME);
+        TRACE_SCOPE("frame");
+        auto now = std::chrono::steady_clock::now();
+        cube.update(now - lastUpdate);
+        cube.getFrameStats().endFrame(
+            std::chrono::duration<double, std::micro>(now - lastUpdate)
+                .count());
+        lastUpdate = now;
+        if (render) {
+          cube.draw(target);
+          ScopedTimer refreshTimer(cube.getFrameStats(), STAGE_REFRESH);
+          TRACE_SCOPE("refresh");
+          if (!output) {
+            renderer.present(target);
+            // 输出之后把画面换给录像，不复制
+            cast.record(target,
+                        std::chrono::duration<double>(now - castStart).count());
+          } else if (output->submit()) {
+            dropped = true;
+            cube.getFrameStats().count(COUNTER_DROPPED_FRAMES);
+          }
+        }
+      }
+      if (render) {
+        governor.record(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - frameStart)
+                            .count(),
+                        dropped);
+      }
+      frame++;
+
+      TRACE_SCOPE("sleep");
       std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
     }
   } catch (const std::exception &e) {
@@ -169,6 +645,188 @@ int main() {
   printf("\033[?1003l\n");
 
   endwin();
+  if (cube.getFrameStats().writeReport(FRAME_STATS_PATH)) {
+    std::cout << "Frame timing written to " << FRAME_STATS_PATH << std::endl;
+  }
+  if (cast.isOpen()) {
+    printCastSummary(cast, options.castPath);
+  }
+#ifdef RUBIK_TRACE
+  if (TRACE_WRITE(TRACE_PATH)) {
+    std::cout << "Trace written to " << TRACE_PATH << std::endl;
+  }
+#endif
   std::cout << "Game ended." << std::endl << "Goodbye!" << std::endl;
   return 0;
 }
+
+// 多魔方视图：交互时按 q/ESC 退出；无终端时按固定步长渲染指定帧数，
+// 输出帧耗时和整段画面的哈希（与线程数无关，可用于核对并行渲染）
+static int runGrid(const Options &options, uint32_t seed,
+                   Renderer &renderer) {
+  CubeGrid grid(options.gridColumns, options.gridRows, seed, options.threads);
+  FrameStats stats;
+  CellBuffer buffer(options.width, options.height);
+  uint64_t frames = options.frames;
+  if (options.headless && frames == 0) {
+    frames = 600;
+  }
+
+  if (!options.headless) {
+    initscr();
+    cbreak();
+    noecho();
+    curs_set(0);
+    nodelay(stdscr, TRUE);
+    start_color();
+    use_default_colors();
+  }
+
+  TRACE_THREAD_NAME("main");
+  uint64_t combined = 0xCBF29CE484222325ULL;
+  uint64_t frame = 0;
+  auto begin = std::chrono::steady_clock::now();
+  auto lastUpdate = begin;
+  for (; frames == 0 || frame < frames; frame++) {
+    if (!options.headless) {
+      bool quit = false;
+      int ch;
+      while ((ch = getch()) != ERR) {
+        quit = quit || ch == 'q' || ch == INPUT_KEY_ESCAPE;
+      }
+      if (quit) {
+        break;
+      }
+      int width, height;
+      getmaxyx(stdscr, height, width);
+      if (buffer.width() != width || buffer.height() != height) {
+        buffer.resize(width, height);
+      }
+    }
+
+    {
+      ScopedTimer frameTimer(stats, STAGE_FRAME);
+      TRACE_SCOPE("frame");
+      auto now = std::chrono::steady_clock::now();
+      grid.update(options.headless ? FRAME_STEP : now - lastUpdate);
+      lastUpdate = now;
+      {
+        ScopedTimer drawTimer(stats, STAGE_RASTER);
+        grid.draw(buffer);
+      }
+      ScopedTimer presentTimer(stats, STAGE_REFRESH);
+      renderer.present(buffer);
+    }
+    combined = (combined ^ buffer.hash()) * 0x100000001B3ULL;
+
+    if (!options.headless) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - begin)
+                       .count();
+  if (!options.headless) {
+    endwin();
+  }
+
+  std::printf("grid: %zu cubes  %dx%d cells  %d threads\n", grid.size(),
+              buffer.width(), buffer.height(), grid.threads());
+  std::printf("frames: %llu  time: %.3f s  fps: %.1f\n",
+              static_cast<unsigned long long>(frame), seconds,
+              seconds > 0 ? frame / seconds : 0.0);
+  std::printf("draw p50: %.3f ms  p99: %.3f ms  max: %.3f ms\n",
+              stats.percentile(STAGE_RASTER, 0.5) / 1000.0,
+              stats.percentile(STAGE_RASTER, 0.99) / 1000.0,
+              stats.maximum(STAGE_RASTER) / 1000.0);
+  std::printf("grid hash: %016llx\n",
+              static_cast<unsigned long long>(combined));
+#ifdef RUBIK_TRACE
+  TRACE_WRITE(TRACE_PATH);
+#endif
+  return 0;
+}
+
+#ifdef RUBIK_SERVER
+static std::atomic<bool> serverStop(false);
+
+static void requestServerStop(int) { serverStop = true; }
+
+// 控制服务器：运行到收到 SIGINT/SIGTERM 为止，退出时输出累计统计
+static int runServer(const Options &options, uint32_t seed) {
+  CubeServer server(seed);
+  if (!server.listen(options.servePath)) {
+    std::cerr << "Cannot listen on " << options.servePath << std::endl;
+    return 1;
+  }
+  std::signal(SIGINT, requestServerStop);
+  std::signal(SIGTERM, requestServerStop);
+  std::cout << "Listening on " << options.servePath << std::endl;
+
+  server.run(serverStop);
+
+  std::printf("sessions: %llu  requests: %llu  moves: %llu\n",
+              static_cast<unsigned long long>(server.sessionsAccepted()),
+              static_cast<unsigned long long>(server.requestsHandled()),
+              static_cast<unsigned long long>(server.movesApplied()));
+  return 0;
+}
+#endif
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+  if (!options.stateText.empty()) {
+    StateError error = CubeFormat::parse(options.stateText, options.state);
+    if (error != STATE_OK) {
+      std::cerr << "Invalid state (" << CubeFormat::errorName(error)
+                << "): " << options.stateText << std::endl;
+      return 1;
+    }
+  }
+
+  uint32_t seed = options.seedGiven ? options.seed : std::random_device()();
+  std::vector<InputRecord> records;
+  if (!options.replayPath.empty()) {
+    uint32_t logSeed = seed;
+    if (!InputLog::load(options.replayPath, records, logSeed)) {
+      std::cerr << "Cannot read input log " << options.replayPath
+                << std::endl;
+      return 1;
+    }
+    if (!options.seedGiven) {
+      seed = logSeed;
+    }
+  }
+
+  if (!options.servePath.empty()) {
+#ifdef RUBIK_SERVER
+    return runServer(options, seed);
+#else
+    std::cerr << "The control server is only available on Linux" << std::endl;
+    return 1;
+#endif
+  }
+
+  std::string rendererName = options.renderer;
+  if (rendererName.empty()) {
+    rendererName = options.headless ? "null" : "curses";
+  }
+  std::unique_ptr<Renderer> renderer =
+      createRenderer(rendererName, options.headless);
+  if (!renderer) {
+    std::cerr << "Unsupported renderer " << rendererName << std::endl;
+    return 1;
+  }
+
+  if (options.gridColumns > 0) {
+    return runGrid(options, seed, *renderer);
+  }
+  if (options.headless) {
+    return runHeadless(options, records, seed, *renderer);
+  }
+  return runInteractive(options, records, seed, *renderer);
+}
@@ -0,0 +1,219 @@
+#include "CubeFormat.hpp"
+#include "CubeState.hpp"
+#include "FaceletCube.hpp"
+#include "Move.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// 逐个与块级模型核对的魔方数（--each 时抽查）
+static constexpr size_t VERIFY_SAMPLES = 1024;
+
+static void printUsage() {
+  std::cout << "Usage: rubik_batch [options]" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Applies random move sequences to a large array of facelet"
+            << std::endl;
+  std::cout << "cubes and reports cube-moves per second for each kernel,"
+            << std::endl;
+  std::cout << "then converts the results to facelet strings and back."
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << "  -n, --cubes N     Number of cubes (default: 1000000)"
+            << std::endl;
+  std::cout << "  -m, --moves N     Moves per cube (default: 100)" << std::endl;
+  std::cout << "  -t, --threads N   Worker threads (default: all cores)"
+            << std::endl;
+  std::cout << "  -k, --kernel NAME scalar, ssse3, avx2, avx512 or all"
+            << std::endl;
+  std::cout << "                    (default: all supported)" << std::endl;
+  std::cout << "  --each            Give every cube its own sequence"
+            << std::endl;
+  std::cout << "  --seed N          Random seed (default: 1)" << std::endl;
+}
+
+// 生成不连续转动同一面的随机序列（转动编号）
+static void randomSequence(std::mt19937 &random, uint8_t *moves,
+                           size_t count) {
+  int last = -1;
+  for (size_t k = 0; k < count; k++) {
+    int face;
+    do {
+      face = static_cast<int>(random() % 6);
+    } while (face == last);
+    last = face;
+    moves[k] = static_cast<uint8_t>(face * 3 + random() % 3);
+  }
+}
+
+// 用块级模型重新推算一个魔方，与贴纸结果比较
+static bool verifyCube(const FaceletCube &cube, const uint8_t *moves,
+                       size_t moveCount) {
+  CubeState state;
+  for (size_t k = 0; k < moveCount; k++) {
+    state.apply(Move::fromIndex(moves[k]));
+  }
+  return FaceletCube::fromState(state) == cube;
+}
+
+// 输出一项转换的耗时和速率
+static void printRate(const char *name, size_t count, double seconds) {
+  std::cout << std::setw(8) << name << "  " << std::fixed
+            << std::setprecision(3) << seconds << " s  "
+            << std::setprecision(1) << std::setw(8)
+            << (seconds > 0 ? count / seconds / 1e6 : 0) << " M states/s"
+            << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+// 把模拟结果识别为块级状态，再写成面块字符串并读回，测量批量转换的速度
+static bool benchmarkFormat(const std::vector<FaceletCube> &cubes) {
+  using Clock = std::chrono::steady_clock;
+  size_t count = cubes.size();
+  std::vector<CubeState> states(count);
+  std::vector<CubeState> parsed(count);
+  std::vector<char> text(count * CubeFormat::LINE_LENGTH);
+
+  auto begin = Clock::now();
+  size_t valid = 0;
+  for (size_t n = 0; n < count; n++) {
+    valid += CubeFormat::fromFacelets(cubes[n], states[n]) == STATE_OK;
+  }
+  auto recognized = Clock::now();
+  CubeFormat::formatFaceletLines(states.data(), count, text.data());
+  auto formatted = Clock::now();
+  valid += CubeFormat::parseFaceletLines(text.data(), count, parsed.data(),
+                                         nullptr);
+  auto end = Clock::now();
+
+  auto seconds = [](Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+  };
+  printRate("identify", count, seconds(begin, recognized));
+  printRate("format", count, seconds(recognized, formatted));
+  printRate("parse", count, seconds(formatted, end));
+  return valid == count * 2 && parsed == states;
+}
+
+int main(int argc, char **argv) {
+  size_t cubeCount = 1000000;
+  size_t moveCount = 100;
+  int threads = 0;
+  bool each = false;
+  uint32_t seed = 1;
+  std::vector<FaceletKernel> kernels;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if ((arg == "-n" || arg == "--cubes") && i + 1 < argc) {
+      cubeCount = std::strtoull(argv[++i], nullptr, 10);
+    } else if ((arg == "-m" || arg == "--moves") && i + 1 < argc) {
+      moveCount = std::strtoull(argv[++i], nullptr, 10);
+    } else if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+      threads = std::atoi(argv[++i]);
+    } else if ((arg == "-k" || arg == "--kernel") && i + 1 < argc) {
+      std::string name = argv[++i];
+      bool known = false;
+      for (int k = 0; k < KERNEL_COUNT; k++) {
+        FaceletKernel kernel = static_cast<FaceletKernel>(k);
+        if (name == "all" || name == FaceletBatch::kernelName(kernel)) {
+          kernels.push_back(kernel);
+          known = true;
+        }
+      }
+      if (!known) {
+        printUsage();
+        return 1;
+      }
+    } else if (arg == "--each") {
+      each = true;
+    } else if (arg == "--seed" && i + 1 < argc) {
+      seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-h" || arg == "--help") {
+      printUsage();
+      return 0;
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+  if (kernels.empty()) {
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+      kernels.push_back(static_cast<FaceletKernel>(k));
+    }
+  }
+
+  ThreadPool pool(threads);
+  std::mt19937 random(seed);
+  std::vector<uint8_t> moves(each ? cubeCount * moveCount : moveCount);
+  for (size_t n = 0; n < (each ? cubeCount : 1); n++) {
+    randomSequence(random, moves.data() + n * moveCount, moveCount);
+  }
+  std::vector<Move> sequence;
+  for (size_t k = 0; k < moveCount && !each; k++) {
+    sequence.push_back(Move::fromIndex(moves[k]));
+  }
+  std::vector<FaceletCube> cubes(cubeCount);
+
+  std::cout << cubeCount << " cubes, " << moveCount << " moves each ("
+            << (each ? "independent" : "shared") << " sequences), "
+            << pool.size() << " threads" << std::endl;
+
+  bool ok = true;
+  for (FaceletKernel kernel : kernels) {
+    if (!FaceletBatch::isSupported(kernel)) {
+      std::cout << std::setw(8) << FaceletBatch::kernelName(kernel)
+                << "  not supported on this CPU" << std::endl;
+      continue;
+    }
+    std::fill(cubes.begin(), cubes.end(), FaceletCube());
+
+    auto begin = std::chrono::steady_clock::now();
+    if (each) {
+      FaceletBatch::applyEach(pool, cubes.data(), cubeCount, moves.data(),
+                              moveCount, kernel);
+    } else {
+      FaceletBatch::applyAll(pool, cubes.data(), cubeCount, sequence.data(),
+                             moveCount, kernel);
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - begin)
+                         .count();
+
+    // 共用序列时只需核对第一个，其余都应与它相同；各自的序列则抽查
+    bool valid = true;
+    if (each) {
+      size_t step = cubeCount / VERIFY_SAMPLES + 1;
+      for (size_t n = 0; n < cubeCount && valid; n += step) {
+        valid = verifyCube(cubes[n], moves.data() + n * moveCount, moveCount);
+      }
+    } else if (cubeCount > 0) {
+      valid = verifyCube(cubes[0], moves.data(), moveCount);
+      for (size_t n = 1; n < cubeCount && valid; n++) {
+        valid = cubes[n] == cubes[0];
+      }
+    }
+    ok = ok && valid;
+
+    double rate = seconds > 0 ? cubeCount * moveCount / seconds : 0;
+    std::cout << std::setw(8) << FaceletBatch::kernelName(kernel) << "  "
+              << std::fixed << std::setprecision(3) << seconds << " s  "
+              << std::setprecision(1) << std::setw(8) << rate / 1e6
+              << " M cube-moves/s  " << (valid ? "ok" : "MISMATCH")
+              << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+  }
+
+  if (!benchmarkFormat(cubes)) {
+    std::cout << "facelet string round trip MISMATCH" << std::endl;
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,309 @@
+#include "CubeProtocol.hpp"
+#include "CubeState.hpp"
+#include "Move.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @struct LoadOptions
+ * @brief 命令行选项
+ */
+struct LoadOptions {
+  std::string socketPath = "rubik.sock"; ///< 服务器套接字
+  int clients = 16;                      ///< 并发连接数
+  int requests = 10000;                  ///< 每个连接的请求数
+  int batch = 20;                        ///< 每个 OP_APPLY 的转动数
+  int depth = 1;                         ///< 每个连接同时在途的请求数
+  int stateEvery = 10;                   ///< 每隔几个请求查询一次状态
+  int solveEvery = 0;                    ///< 每隔几个请求求解一次（0：不求解）
+};
+
+/**
+ * @struct ClientResult
+ * @brief 一个连接的测量结果
+ */
+struct ClientResult {
+  std::vector<uint32_t> latency[OP_SOLVE + 1]; ///< 各操作的延迟（纳秒）
+  uint64_t moves = 0;                          ///< 发送的转动数
+  uint64_t mismatches = 0; ///< 服务器状态与本地推算不一致的次数
+  uint64_t errors = 0;     ///< 非 STATUS_OK 响应数
+  bool failed = false;     ///< 连接或读写失败
+};
+
+// 请求在途时记录的信息，按发送顺序与响应一一对应
+struct Pending {
+  int opcode;
+  std::chrono::steady_clock::time_point sent;
+  CubeState expected; ///< OP_STATE：发送时本地推算的状态
+};
+
+static void printUsage() {
+  std::cout << "Usage: rubik_loadgen [options]" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Drives a running 'rubik --serve PATH' and reports throughput"
+            << std::endl;
+  std::cout << "and latency percentiles." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << "  -s, --socket PATH  Server socket (default: rubik.sock)"
+            << std::endl;
+  std::cout << "  -c, --clients N    Concurrent connections (default: 16)"
+            << std::endl;
+  std::cout << "  -n, --requests N   Requests per connection (default: 10000)"
+            << std::endl;
+  std::cout << "  -b, --batch N      Moves per apply request (default: 20)"
+            << std::endl;
+  std::cout << "  -d, --depth N      Requests in flight per connection"
+            << " (default: 1)" << std::endl;
+  std::cout << "  --state-every N    Query the state every N requests"
+            << " (default: 10, 0: never)" << std::endl;
+  std::cout << "  --solve-every N    Ask for a solution every N requests"
+            << " (default: 0: never)" << std::endl;
+}
+
+static bool writeAll(int fd, const uint8_t *data, size_t size) {
+  while (size > 0) {
+    ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+    if (sent <= 0) {
+      return false;
+    }
+    data += sent;
+    size -= static_cast<size_t>(sent);
+  }
+  return true;
+}
+
+static bool readAll(int fd, uint8_t *data, size_t size) {
+  while (size > 0) {
+    ssize_t received = ::read(fd, data, size);
+    if (received <= 0) {
+      return false;
+    }
+    data += received;
+    size -= static_cast<size_t>(received);
+  }
+  return true;
+}
+
+static int connectTo(const std::string &path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    return -1;
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr *>(&address),
+                           sizeof(address)) != 0) {
+    ::close(fd);
+    fd = -1;
+  }
+  return fd;
+}
+
+// 读取一个响应并与最早的在途请求对应
+static bool receive(int fd, std::deque<Pending> &pending,
+                    ClientResult &result) {
+  uint8_t header[CubeProtocol::HEADER_SIZE];
+  uint8_t payload[CubeProtocol::MAX_PAYLOAD];
+  if (!readAll(fd, header, sizeof(header))) {
+    return false;
+  }
+  size_t length = CubeProtocol::payloadLength(header);
+  if (length > sizeof(payload) || !readAll(fd, payload, length)) {
+    return false;
+  }
+  auto now = std::chrono::steady_clock::now();
+
+  Pending request = pending.front();
+  pending.pop_front();
+  result.latency[request.opcode].push_back(static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - request.sent)
+          .count()));
+  if (header[0] != STATUS_OK) {
+    result.errors++;
+  } else if (request.opcode == OP_STATE) {
+    const CubeState &expected = request.expected;
+    bool same = length == CubeProtocol::STATE_SIZE &&
+                std::memcmp(payload, expected.cp, 8) == 0 &&
+                std::memcmp(payload + 8, expected.co, 8) == 0 &&
+                std::memcmp(payload + 16, expected.ep, 12) == 0 &&
+                std::memcmp(payload + 28, expected.eo, 12) == 0;
+    result.mismatches += same ? 0 : 1;
+  }
+  return true;
+}
+
+// 一个连接：先还原服务器上的魔方，之后按比例混合发送转动、查询和求解，
+// 本地同步推算状态，用于核对查询结果
+static void runClient(const LoadOptions &options, uint32_t seed,
+                      ClientResult &result) {
+  int fd = connectTo(options.socketPath);
+  if (fd < 0) {
+    result.failed = true;
+    return;
+  }
+
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<> moveDist(0, Move::COUNT - 1);
+  CubeState local;
+  std::deque<Pending> pending;
+  std::vector<uint8_t> request;
+
+  for (int i = 0; i <= options.requests && !result.failed; i++) {
+    int opcode = OP_APPLY;
+    if (i == 0) {
+      opcode = OP_RESET;
+    } else if (options.solveEvery > 0 && i % options.solveEvery == 0) {
+      opcode = OP_SOLVE;
+    } else if (options.stateEvery > 0 && i % options.stateEvery == 0) {
+      opcode = OP_STATE;
+    }
+
+    request.assign(CubeProtocol::HEADER_SIZE, 0);
+    if (opcode == OP_RESET) {
+      local = CubeState();
+    } else if (opcode == OP_APPLY) {
+      for (int m = 0; m < options.batch; m++) {
+        Move move = Move::fromIndex(moveDist(random));
+        local.apply(move);
+        request.push_back(static_cast<uint8_t>(move.index()));
+      }
+      result.moves += static_cast<uint64_t>(options.batch);
+    }
+    CubeProtocol::writeHeader(request.data(), opcode,
+                              request.size() - CubeProtocol::HEADER_SIZE);
+
+    pending.push_back(Pending{opcode, std::chrono::steady_clock::now(),
+                              local});
+    if (!writeAll(fd, request.data(), request.size())) {
+      result.failed = true;
+      break;
+    }
+    while (static_cast<int>(pending.size()) >= options.depth &&
+           !result.failed) {
+      result.failed = !receive(fd, pending, result);
+    }
+  }
+  while (!pending.empty() && !result.failed) {
+    result.failed = !receive(fd, pending, result);
+  }
+  ::close(fd);
+}
+
+static double percentileMs(const std::vector<uint32_t> &sorted, double p) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[index] / 1e6;
+}
+
+static void printLatency(const char *name, std::vector<uint32_t> &samples) {
+  if (samples.empty()) {
+    return;
+  }
+  std::sort(samples.begin(), samples.end());
+  std::printf("%-8s %9zu  p50 %8.3f  p90 %8.3f  p99 %8.3f  p99.9 %8.3f  "
+              "max %8.3f ms\n",
+              name, samples.size(), percentileMs(samples, 0.5),
+              percentileMs(samples, 0.9), percentileMs(samples, 0.99),
+              percentileMs(samples, 0.999), samples.back() / 1e6);
+}
+
+int main(int argc, char **argv) {
+  LoadOptions options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if ((arg == "-s" || arg == "--socket") && hasValue) {
+      options.socketPath = argv[++i];
+    } else if ((arg == "-c" || arg == "--clients") && hasValue) {
+      options.clients = std::atoi(argv[++i]);
+    } else if ((arg == "-n" || arg == "--requests") && hasValue) {
+      options.requests = std::atoi(argv[++i]);
+    } else if ((arg == "-b" || arg == "--batch") && hasValue) {
+      options.batch = std::atoi(argv[++i]);
+    } else if ((arg == "-d" || arg == "--depth") && hasValue) {
+      options.depth = std::atoi(argv[++i]);
+    } else if (arg == "--state-every" && hasValue) {
+      options.stateEvery = std::atoi(argv[++i]);
+    } else if (arg == "--solve-every" && hasValue) {
+      options.solveEvery = std::atoi(argv[++i]);
+    } else if (arg == "-h" || arg == "--help") {
+      printUsage();
+      return 0;
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+  if (options.clients <= 0 || options.requests <= 0 || options.depth <= 0 ||
+      options.batch < 0 ||
+      options.batch > static_cast<int>(CubeProtocol::MAX_PAYLOAD)) {
+    printUsage();
+    return 1;
+  }
+
+  std::vector<ClientResult> results(options.clients);
+  std::vector<std::thread> threads;
+  auto begin = std::chrono::steady_clock::now();
+  for (int c = 0; c < options.clients; c++) {
+    threads.emplace_back(runClient, std::cref(options),
+                         static_cast<uint32_t>(c + 1), std::ref(results[c]));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - begin)
+                       .count();
+
+  // 合并各连接的结果
+  ClientResult total;
+  int failed = 0;
+  for (ClientResult &result : results) {
+    for (int op = 0; op <= OP_SOLVE; op++) {
+      total.latency[op].insert(total.latency[op].end(),
+                               result.latency[op].begin(),
+                               result.latency[op].end());
+    }
+    total.moves += result.moves;
+    total.mismatches += result.mismatches;
+    total.errors += result.errors;
+    failed += result.failed ? 1 : 0;
+  }
+  std::vector<uint32_t> all;
+  for (int op = 0; op <= OP_SOLVE; op++) {
+    all.insert(all.end(), total.latency[op].begin(), total.latency[op].end());
+  }
+
+  std::printf("clients: %d  depth: %d  batch: %d  time: %.3f s\n",
+              options.clients, options.depth, options.batch, seconds);
+  std::printf("requests: %zu  (%.0f req/s)  moves: %llu  (%.0f moves/s)\n",
+              all.size(), seconds > 0 ? all.size() / seconds : 0.0,
+              static_cast<unsigned long long>(total.moves),
+              seconds > 0 ? total.moves / seconds : 0.0);
+  printLatency("all", all);
+  printLatency("apply", total.latency[OP_APPLY]);
+  printLatency("state", total.latency[OP_STATE]);
+  printLatency("solve", total.latency[OP_SOLVE]);
+  std::printf("errors: %llu  state mismatches: %llu  failed clients: %d\n",
+              static_cast<unsigned long long>(total.errors),
+              static_cast<unsigned long long>(total.mismatches), failed);
+  return total.errors == 0 && total.mismatches == 0 && failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+#include "PatternDatabase.hpp"
+#include "TwoByTwoSolver.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// 进程的峰值常驻内存（MB），不支持的平台返回-1
+static double peakMemoryMB() {
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+  return usage.ru_maxrss / 1024.0;
+#endif
+#else
+  return -1;
+#endif
+}
+
+static void printUsage() {
+  std::cout << "Usage: rubik_pdb [options] "
+               "[corners|edges-low|edges-high|2x2|all]"
+            << std::endl;
+  std::cout << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << "  -t, --threads N  Worker threads (default: all cores)"
+            << std::endl;
+  std::cout << "  -o, --output DIR Output directory (default: .)" << std::endl;
+  std::cout << "  --mod3           Store distance mod 3 in 2 bits" << std::endl;
+  std::cout << "                   (the 2x2 table always does)" << std::endl;
+  std::cout << "  --verify         Only mmap and check existing tables"
+            << std::endl;
+}
+
+// 输出每层的状态数
+static void printLevels(const BuildStats &stats) {
+  for (size_t depth = 0; depth < stats.levelCounts.size(); depth++) {
+    std::cout << "  depth " << std::setw(2) << depth << ": " << std::setw(10)
+              << stats.levelCounts[depth] << std::endl;
+  }
+}
+
+// 输出耗时、表大小和峰值内存
+static void printSummary(const BuildStats &stats, size_t tableBytes) {
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "  build time: " << stats.seconds << " s" << std::endl;
+  std::cout << "  table size: " << tableBytes / (1024.0 * 1024.0) << " MB"
+            << std::endl;
+  std::cout << "  peak RAM:   " << peakMemoryMB() << " MB" << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+}
+
+// 生成一张表并写入文件，随后重新映射以校验文件
+static bool buildTable(PatternKind kind, int bits, int threads,
+                       const std::string &path) {
+  PatternDatabase database(kind, bits);
+  std::cout << "[" << PatternDatabase::name(kind) << "] generating "
+            << PatternDatabase::entryCount(kind) << " entries, " << bits
+            << " bits each" << std::endl;
+
+  BuildStats stats = database.generate(threads);
+  printLevels(stats);
+  if (!database.save(path)) {
+    std::cerr << "  failed to write " << path << std::endl;
+    return false;
+  }
+  printSummary(stats, database.tableBytes());
+  return true;
+}
+
+// 生成 2x2x2 距离表（固定每项2位）并写入文件
+static bool buildTwoByTwo(int threads, const std::string &path) {
+  TwoByTwoSolver solver;
+  std::cout << "[2x2] generating " << TwoByTwoSolver::STATE_COUNT
+            << " entries, 2 bits each" << std::endl;
+
+  BuildStats stats = solver.generate(threads);
+  printLevels(stats);
+  if (!solver.save(path)) {
+    std::cerr << "  failed to write " << path << std::endl;
+    return false;
+  }
+  printSummary(stats, (TwoByTwoSolver::STATE_COUNT + 31) / 32 *
+                          sizeof(uint64_t));
+  return true;
+}
+
+// 映射已有的表并校验文件头与校验和
+static bool verifyTable(PatternKind kind, int bits, const std::string &path) {
+  PatternDatabase database(kind, bits);
+  auto begin = std::chrono::steady_clock::now();
+  bool ok = database.load(path) && database.distance(CubeState(), 0) == 0;
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - begin)
+                  .count();
+
+  std::cout << "[" << PatternDatabase::name(kind) << "] " << path << ": "
+            << (ok ? "ok" : "INVALID") << " (" << std::fixed
+            << std::setprecision(2) << ms << " ms)" << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+  return ok;
+}
+
+// 映射已有的 2x2x2 距离表，校验文件头与校验和，并检查还原状态和一步
+// 之外的状态的距离
+static bool verifyTwoByTwo(const std::string &path) {
+  TwoByTwoSolver solver;
+  auto begin = std::chrono::steady_clock::now();
+  CubeState turned;
+  turned.apply(Move(FACE_R, 1));
+  bool ok = solver.load(path) && solver.distance(CubeState()) == 0 &&
+            solver.distance(turned) == 1;
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - begin)
+                  .count();
+
+  std::cout << "[2x2] " << path << ": " << (ok ? "ok" : "INVALID") << " ("
+            << std::fixed << std::setprecision(2) << ms << " ms)" << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  int threads = 0;
+  int bits = 4;
+  bool verify = false;
+  bool twoByTwo = false;
+  std::string output = ".";
+  std::vector<PatternKind> kinds;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+      threads = std::atoi(argv[++i]);
+    } else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+      output = argv[++i];
+    } else if (arg == "--mod3") {
+      bits = 2;
+    } else if (arg == "--verify") {
+      verify = true;
+    } else if (arg == "all") {
+      kinds = {PATTERN_CORNERS, PATTERN_EDGES_LOW, PATTERN_EDGES_HIGH};
+      twoByTwo = true;
+    } else if (arg == "2x2") {
+      twoByTwo = true;
+    } else if (arg == "-h" || arg == "--help") {
+      printUsage();
+      return 0;
+    } else {
+      bool known = false;
+      for (int k = 0; k < PATTERN_KIND_COUNT; k++) {
+        if (arg == PatternDatabase::name(static_cast<PatternKind>(k))) {
+          kinds.push_back(static_cast<PatternKind>(k));
+          known = true;
+        }
+      }
+      if (!known) {
+        printUsage();
+        return 1;
+      }
+    }
+  }
+  if (kinds.empty() && !twoByTwo) {
+    kinds = {PATTERN_CORNERS, PATTERN_EDGES_LOW, PATTERN_EDGES_HIGH};
+    twoByTwo = true;
+  }
+
+  if (threads <= 0) {
+    threads = TableBuilder::defaultThreads();
+  }
+  if (!verify) {
+    std::cout << "Using " << threads << " threads" << std::endl;
+  }
+
+  bool ok = true;
+  for (PatternKind kind : kinds) {
+    std::string path = output + "/" + PatternDatabase::name(kind) +
+                       (bits == 2 ? ".mod3.pdb" : ".pdb");
+    ok = (verify ? verifyTable(kind, bits, path)
+                 : buildTable(kind, bits, threads, path)) &&
+         ok;
+  }
+  if (twoByTwo) {
+    std::string path = output + "/2x2.pdb";
+    ok = (verify ? verifyTwoByTwo(path) : buildTwoByTwo(threads, path)) && ok;
+  }
+  return ok ? 0 : 1;
+}
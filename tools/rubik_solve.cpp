@@ -0,0 +1,335 @@
+#include "BidirectionalSolver.hpp"
+#include "CubeFormat.hpp"
+#include "CubeState.hpp"
+#include "IdaStarSolver.hpp"
+#include "Move.hpp"
+#include "RubiksCube.hpp"
+#include "TwoByTwoSolver.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static void printUsage() {
+  std::cout << "Usage: rubik_solve [options] [STATE ...]" << std::endl;
+  std::cout << std::endl;
+  std::cout << "Finds optimal solutions with a bidirectional breadth-first"
+            << std::endl;
+  std::cout << "search and reports the frontier size and time of each depth,"
+            << std::endl;
+  std::cout << "or with IDA* bounded by the pattern databases (--tables)."
+            << std::endl;
+  std::cout << "A STATE is a facelet string, cubie notation or a move"
+            << std::endl;
+  std::cout << "sequence (the state it reaches from solved). Without STATE"
+            << std::endl;
+  std::cout << "arguments or --random, states are read from stdin, one per"
+            << std::endl;
+  std::cout << "line." << std::endl;
+  std::cout << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << "  -m, --memory MB   Memory cap (default: 1024)" << std::endl;
+  std::cout << "  -d, --depth N     Give up beyond N moves (default: 20)"
+            << std::endl;
+  std::cout << "  -r, --random N    Solve N random scrambles" << std::endl;
+  std::cout << "  -l, --length N    Random scramble length (default: 10)"
+            << std::endl;
+  std::cout << "  --seed N          Random seed (default: 1)" << std::endl;
+  std::cout << "  --tables DIR      Use IDA* with corners.pdb, edges-low.pdb"
+            << std::endl;
+  std::cout << "                    and edges-high.pdb from rubik_pdb -o DIR"
+            << std::endl;
+  std::cout << "  -t, --threads N   IDA* threads (default: all cores)"
+            << std::endl;
+  std::cout << "  --2x2 FILE        Solve only the corners (as a 2x2 cube) with"
+            << std::endl;
+  std::cout << "                    the table from rubik_pdb 2x2 and check"
+            << std::endl;
+  std::cout << "                    each step against the table" << std::endl;
+}
+
+// 生成不连续转动同一面的随机打乱
+static std::vector<Move> randomScramble(std::mt19937 &random, int length) {
+  std::vector<Move> moves;
+  int last = -1;
+  for (int k = 0; k < length; k++) {
+    int face;
+    do {
+      face = static_cast<int>(random() % 6);
+    } while (face == last);
+    last = face;
+    moves.push_back(Move::fromIndex(face * 3 + static_cast<int>(random() % 3)));
+  }
+  return moves;
+}
+
+// 解析状态文本：先按面块字符串或块记号，否则按转动序列；
+// 两者都不成立时返回按面块字符串或块记号校验的结果
+static StateError parseState(const std::string &text, CubeState &state) {
+  StateError error = CubeFormat::parse(text, state);
+  if (error == STATE_OK) {
+    return STATE_OK;
+  }
+  std::vector<Move> moves;
+  if (!Move::parseSequence(text, moves)) {
+    return error;
+  }
+  state = CubeState();
+  for (const Move &move : moves) {
+    state.apply(move);
+  }
+  return STATE_OK;
+}
+
+// 输出解并检查它能还原该状态
+static bool printSolution(const CubeState &state,
+                          const std::vector<Move> &solution) {
+  CubeState check = state;
+  for (const Move &move : solution) {
+    check.apply(move);
+  }
+  std::cout << "  solution (" << solution.size() << " moves):";
+  for (const Move &move : solution) {
+    std::cout << ' ' << move.toString();
+  }
+  std::cout << std::endl;
+  if (!check.isSolved()) {
+    std::cout << "  solution does not solve the state" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// 求解一个状态并输出各层统计；解须能还原该状态
+static bool solveState(BidirectionalSolver &solver, const CubeState &state) {
+  std::cout << CubeFormat::toFacelets(state) << std::endl;
+  std::vector<Move> solution;
+  auto begin = std::chrono::steady_clock::now();
+  bool found = solver.solve(state, solution);
+  double milliseconds = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - begin)
+                            .count();
+
+  const BidirectionalStats &stats = solver.lastStats();
+  std::cout << std::fixed << std::setprecision(1);
+  for (const FrontierLevel &level : stats.levels) {
+    std::cout << "  " << (level.backward ? "goal " : "start") << " depth "
+              << std::setw(2) << level.depth << ": " << std::setw(10)
+              << level.states << " states (" << std::setw(10)
+              << level.generated << " generated) " << std::setw(8)
+              << level.milliseconds << " ms" << std::endl;
+  }
+  std::cout << "  cached goal depth " << stats.cachedDepth << ", peak "
+            << stats.peakBytes / 1048576.0 << " MB, " << milliseconds
+            << " ms" << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+
+  if (!found) {
+    std::cout << "  no solution"
+              << (stats.limitReached   ? " within the memory cap"
+                  : stats.depthReached ? " within the depth cap"
+                                       : "")
+              << std::endl;
+    return false;
+  }
+  return printSolution(state, solution);
+}
+
+// 用 IDA* 求解一个状态并输出各轮迭代的统计；解须能还原该状态
+static bool searchState(IdaStarSolver &solver, const CubeState &state,
+                        int maxDepth) {
+  std::cout << CubeFormat::toFacelets(state) << std::endl;
+  std::vector<Move> solution;
+  auto begin = std::chrono::steady_clock::now();
+  bool found = solver.solve(state, solution, maxDepth);
+  double milliseconds = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - begin)
+                            .count();
+
+  const IdaStats &stats = solver.lastStats();
+  std::cout << std::fixed << std::setprecision(1);
+  for (const IdaIteration &iteration : stats.iterations) {
+    std::cout << "  bound " << std::setw(2) << iteration.bound << ": "
+              << std::setw(12) << iteration.nodes << " nodes ("
+              << std::setw(10) << iteration.tableHits << " table hits) "
+              << std::setw(10) << iteration.milliseconds << " ms"
+              << std::endl;
+  }
+  std::cout << "  lower bound " << stats.startBound << ", " << milliseconds
+            << " ms, " << stats.rootTasks << " of " << stats.prefixes
+            << " two-move prefixes after symmetry" << std::endl;
+  std::cout.unsetf(std::ios::floatfield);
+
+  if (!found) {
+    std::cout << "  no solution within the depth cap" << std::endl;
+    return false;
+  }
+  return printSolution(state, solution);
+}
+
+// 每个面的4个角贴纸颜色相同，即角块整体还原（允许相对中心转过一个角度）
+static bool cornersSolved(const CubeState &state) {
+  std::string facelets = CubeFormat::toFacelets(state);
+  for (size_t face = 0; face < facelets.size(); face += 9) {
+    char color = facelets[face];
+    if (facelets[face + 2] != color || facelets[face + 6] != color ||
+        facelets[face + 8] != color) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 把状态放进 RubiksCube，按 2x2 魔方求解它的角块，并逐步核对贪心下降：
+// 解的第 k 步之后，剩余状态在表中的距离应恰好少 k，最后为0，且角块确实
+// 已经还原
+static bool solveCorners(const TwoByTwoSolver &solver, RubiksCube &cube,
+                         const CubeState &state, std::vector<int> &lengths) {
+  cube.setState(state);
+  CubeState corners = cube.getState();
+  std::vector<Move> solution = solver.solve(corners);
+  int length = static_cast<int>(solution.size());
+  bool ok = solver.distance(corners) == length;
+  for (const Move &move : solution) {
+    corners.apply(move);
+    ok = ok && solver.distance(corners) == --length;
+  }
+  ok = ok && length == 0 && cornersSolved(corners);
+
+  std::cout << CubeFormat::toFacelets(state) << std::endl;
+  std::cout << "  2x2 solution (" << solution.size() << " moves):";
+  for (const Move &move : solution) {
+    std::cout << ' ' << move.toString();
+  }
+  std::cout << std::endl;
+  if (!ok) {
+    std::cout << "  solution does not descend the table" << std::endl;
+    return false;
+  }
+  if (lengths.size() <= solution.size()) {
+    lengths.resize(solution.size() + 1);
+  }
+  lengths[solution.size()]++;
+  return true;
+}
+
+int main(int argc, char **argv) {
+  size_t memoryMb = BidirectionalSolver::DEFAULT_MEMORY_MB;
+  int maxDepth = BidirectionalSolver::DEFAULT_MAX_DEPTH;
+  int randomCount = 0;
+  int length = 10;
+  uint32_t seed = 1;
+  std::vector<std::string> texts;
+  std::string twoByTwoPath;
+  std::string tablesPath;
+  int threads = 0;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if ((arg == "-m" || arg == "--memory") && i + 1 < argc) {
+      memoryMb = std::strtoull(argv[++i], nullptr, 10);
+    } else if ((arg == "-d" || arg == "--depth") && i + 1 < argc) {
+      maxDepth = std::atoi(argv[++i]);
+    } else if ((arg == "-r" || arg == "--random") && i + 1 < argc) {
+      randomCount = std::atoi(argv[++i]);
+    } else if ((arg == "-l" || arg == "--length") && i + 1 < argc) {
+      length = std::atoi(argv[++i]);
+    } else if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+      threads = std::atoi(argv[++i]);
+    } else if (arg == "--tables" && i + 1 < argc) {
+      tablesPath = argv[++i];
+    } else if (arg == "--2x2" && i + 1 < argc) {
+      twoByTwoPath = argv[++i];
+    } else if (arg == "--seed" && i + 1 < argc) {
+      seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "-h" || arg == "--help") {
+      printUsage();
+      return 0;
+    } else if (!arg.empty() && arg[0] == '-') {
+      printUsage();
+      return 1;
+    } else {
+      texts.push_back(arg);
+    }
+  }
+
+  std::vector<CubeState> states;
+  std::mt19937 random(seed);
+  for (int n = 0; n < randomCount; n++) {
+    CubeState state;
+    for (const Move &move : randomScramble(random, length)) {
+      state.apply(move);
+    }
+    states.push_back(state);
+  }
+  if (texts.empty() && randomCount == 0) {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+      if (!line.empty()) {
+        texts.push_back(line);
+      }
+    }
+  }
+  for (const std::string &text : texts) {
+    CubeState state;
+    StateError error = parseState(text, state);
+    if (error != STATE_OK) {
+      std::cout << "Invalid state (" << CubeFormat::errorName(error)
+                << "): " << text << std::endl;
+      return 1;
+    }
+    states.push_back(state);
+  }
+
+  if (!twoByTwoPath.empty()) {
+    TwoByTwoSolver solver;
+    if (!solver.load(twoByTwoPath)) {
+      std::cout << "Cannot load " << twoByTwoPath << std::endl;
+      return 1;
+    }
+    RubiksCube cube;
+    std::vector<int> lengths;
+    bool ok = true;
+    auto begin = std::chrono::steady_clock::now();
+    for (const CubeState &state : states) {
+      ok = solveCorners(solver, cube, state, lengths) && ok;
+    }
+    double milliseconds = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - begin)
+                              .count();
+    std::cout << "2x2 solution lengths:";
+    for (size_t length = 0; length < lengths.size(); length++) {
+      std::cout << ' ' << length << ':' << lengths[length];
+    }
+    std::cout << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << states.size()
+              << " states in " << milliseconds << " ms" << std::endl;
+    return ok ? 0 : 1;
+  }
+
+  if (!tablesPath.empty()) {
+    IdaStarSolver solver(threads);
+    if (!solver.loadTables(tablesPath)) {
+      std::cout << "Cannot load the pattern databases in " << tablesPath
+                << std::endl;
+      return 1;
+    }
+    std::cout << solver.threadCount() << " threads, transposition table "
+              << (solver.tableSlots() * 16 >> 20) << " MB" << std::endl;
+    bool ok = true;
+    for (const CubeState &state : states) {
+      ok = searchState(solver, state, maxDepth) && ok;
+    }
+    return ok ? 0 : 1;
+  }
+
+  BidirectionalSolver solver(memoryMb << 20, maxDepth);
+  bool ok = true;
+  for (const CubeState &state : states) {
+    ok = solveState(solver, state) && ok;
+  }
+  return ok ? 0 : 1;
+}